@@ -0,0 +1,77 @@
+#!/bin/bash
+#
+# Build the SPIFFS image contents in src/data from the web UI sources
+# in src/html and the libraries in lib/js.
+#
+# Text assets are minified, when the tools are installed, and gzipped,
+# the web server sends the .gz with Content-Encoding: gzip. References
+# from home.html get a ?v=<hash> of the file so they can be cached for
+# good, home.html itself is checked with its ETag on every load.
+#
+# Minifiers used if found on the PATH:
+#   npm install -g terser clean-css-cli html-minifier
+
+LIB_DIR=$(dirname $(realpath $0))
+HTML_DIR=$LIB_DIR/../src/html
+DATA_DIR=$LIB_DIR/../src/data
+
+set -e
+
+minify() {
+  case "$1" in
+    *.js)
+      if which terser > /dev/null; then
+        terser "$1" -c -m
+        return
+      fi
+      ;;
+    *.css)
+      if which cleancss > /dev/null; then
+        cleancss "$1"
+        return
+      fi
+      ;;
+    *.html)
+      if which html-minifier > /dev/null; then
+        html-minifier --collapse-whitespace --remove-comments \
+          --minify-css true --minify-js true "$1"
+        return
+      fi
+      ;;
+  esac
+  echo "Not minifying $(basename $1)" >&2
+  cat "$1"
+}
+
+version() {
+  sha1sum "$1" | cut -c1-8
+}
+
+mkdir -p $DATA_DIR
+rm -f $DATA_DIR/*
+
+bash $LIB_DIR/js/combine.sh
+
+for file in config.js style.css; do
+  minify $HTML_DIR/$file | gzip -9 -n -c > $DATA_DIR/$file.gz
+done
+cp $HTML_DIR/*.jpg $DATA_DIR/
+
+# Version the references from home.html
+TMP_DIR=$(mktemp -d)
+cp $HTML_DIR/home.html $TMP_DIR/
+for file in lib.js config.js style.css; do
+  sed -i "s/\"$file\"/\"$file?v=$(version $DATA_DIR/$file.gz)\"/" $TMP_DIR/home.html
+done
+for file in $(cd $HTML_DIR && ls *.jpg); do
+  sed -i "s/\"$file\"/\"$file?v=$(version $DATA_DIR/$file)\"/" $TMP_DIR/home.html
+done
+minify $TMP_DIR/home.html | gzip -9 -n -c > $DATA_DIR/home.html.gz
+rm -r $TMP_DIR
+
+# Page load, before is the sources as served uncompressed
+before=$(cat $HTML_DIR/home.html $HTML_DIR/config.js $HTML_DIR/style.css \
+             $HTML_DIR/*.jpg $LIB_DIR/js/jquery.slim.min.js \
+             $LIB_DIR/js/knockout.min.js $LIB_DIR/js/knockout.mapping.min.js | wc -c)
+after=$(cat $DATA_DIR/* | wc -c)
+echo "Page load: $before bytes uncompressed, $after bytes as built"
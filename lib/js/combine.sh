@@ -3,12 +3,12 @@
 LIB_DIR=$(dirname $(realpath $0))
 SRC_DIR=$LIB_DIR/../../src/data
 
-rm $SRC_DIR/lib.*
+rm -f $SRC_DIR/lib.*
 
-C=0
+C=1
 
 if [ 1 -eq $C ]; then
-  COMP="gzip -c"
+  COMP="gzip -9 -n -c"
   OUT=.gz
 else
   COMP="cat"
@@ -0,0 +1,130 @@
+#include "emonesp.h"
+#include "assets.h"
+#include "config.h"
+#include "debug.h"
+
+#include <Arduino.h>
+#include <FS.h>
+
+struct AssetsFile {
+  char path[32];                // As asked for, without the .gz
+  char etag[12];
+};
+
+static AssetsFile assets_files[ASSETS_MAX_FILES];
+static int assets_count = 0;
+static int assets_next = 0;     // Slot to reuse once full
+
+// The name the file is stored under, NULL if there is no such file
+static const char *
+assets_stored(const String &path, String &stored) {
+  if (path.length() >= sizeof(assets_files[0].path)) {
+    return NULL;
+  }
+  if (SPIFFS.exists(path)) {
+    stored = path;
+    return stored.c_str();
+  }
+  stored = path + ".gz";
+  if (SPIFFS.exists(stored)) {
+    return stored.c_str();
+  }
+  return NULL;
+}
+
+static const char *
+assets_etag(const char *path, const char *stored) {
+  for (int i = 0; i < assets_count; i++) {
+    if (0 == strcmp(path, assets_files[i].path)) {
+      return assets_files[i].etag;
+    }
+  }
+
+  File file = SPIFFS.open(stored, "r");
+  if (!file) {
+    return NULL;
+  }
+  uint32_t hash = 2166136261UL;       // FNV-1a
+  uint8_t buf[128];
+  size_t len;
+  while ((len = file.read(buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < len; i++) {
+      hash = (hash ^ buf[i]) * 16777619UL;
+    }
+  }
+  file.close();
+
+  AssetsFile &entry = assets_files[assets_next];
+  assets_next = (assets_next + 1) % ASSETS_MAX_FILES;
+  if (assets_count < ASSETS_MAX_FILES) {
+    assets_count++;
+  }
+  strlcpy(entry.path, path, sizeof(entry.path));
+  snprintf(entry.etag, sizeof(entry.etag), "\"%08x\"", (unsigned int)hash);
+  return entry.etag;
+}
+
+bool
+assets_send(AsyncWebServerRequest *request, const char *path) {
+  String stored;
+  if (NULL == assets_stored(path, stored)) {
+    return false;
+  }
+
+  const char *etag = assets_etag(path, stored.c_str());
+  if (NULL != etag && request->hasHeader("If-None-Match") &&
+      request->getHeader("If-None-Match")->value() == etag) {
+    AsyncWebServerResponse *response = request->beginResponse(304);
+    response->addHeader("ETag", etag);
+    request->send(response);
+    return true;
+  }
+
+  // Picks up the .gz and sets Content-Encoding itself
+  AsyncWebServerResponse *response = request->beginResponse(SPIFFS, path);
+  if (NULL != etag) {
+    response->addHeader("ETag", etag);
+  }
+  if (request->hasParam("v")) {
+    response->addHeader("Cache-Control", "public, max-age=" ASSETS_MAX_AGE ", immutable");
+  } else {
+    response->addHeader("Cache-Control", "no-cache");
+  }
+  request->send(response);
+  return true;
+}
+
+// -------------------------------------------------------------------
+// Serves any GET that names a file in SPIFFS
+// -------------------------------------------------------------------
+class AssetsHandler : public AsyncWebHandler {
+  public:
+    bool canHandle(AsyncWebServerRequest *request) {
+      if (HTTP_GET != request->method() && HTTP_HEAD != request->method()) {
+        return false;
+      }
+      String stored;
+      if (NULL == assets_stored(request->url(), stored)) {
+        return false;
+      }
+      request->addInterestingHeader("If-None-Match");
+      return true;
+    }
+
+    void handleRequest(AsyncWebServerRequest *request) {
+      if (config_www_username()[0] &&
+          !request->authenticate(config_www_username(), config_www_password())) {
+        return request->requestAuthentication();
+      }
+      if (!assets_send(request, request->url().c_str())) {
+        request->send(404);
+      }
+    }
+};
+
+static AssetsHandler assets_handler;
+
+void
+assets_setup(AsyncWebServer &server) {
+  server.addHandler(&assets_handler);
+}
@@ -0,0 +1,26 @@
+#ifndef _EMONESP_ASSETS_H
+#define _EMONESP_ASSETS_H
+
+#include <ESPAsyncWebServer.h>
+
+// -------------------------------------------------------------------
+// The web UI files from SPIFFS
+//
+// lib/build_data.sh stores the text files as <name>.gz, they are sent
+// as is with Content-Encoding: gzip. Each file gets an ETag from a hash
+// of what is stored, worked out the first time it is asked for, so a
+// browser that has it is sent a 304 rather than the file.
+//
+// home.html asks for the other files as <name>?v=<hash>, a new build
+// changes the URL so those can be cached for good. Anything else has
+// to be checked with its ETag each time.
+// -------------------------------------------------------------------
+#define ASSETS_MAX_FILES    12      // ETags remembered
+#define ASSETS_MAX_AGE      "31536000"
+
+extern void assets_setup(AsyncWebServer &server);
+
+// Send a file, false if it is not in SPIFFS. Does not authenticate.
+extern bool assets_send(AsyncWebServerRequest *request, const char *path);
+
+#endif // _EMONESP_ASSETS_H
@@ -1,233 +1,366 @@
 #include "emonesp.h"
 #include "config.h"
+#include "config_store.h"
+#include "json.h"
+#include "debug.h"
 
 #include <Arduino.h>
-#include <EEPROM.h>             // Save config settings
-
-// Wifi Network Strings
-String esid = "";
-String epass = "";
-
-// Web server authentication (leave blank for none)
-String www_username = "";
-String www_password = "";
-
-// EMONCMS SERVER strings
-String emoncms_server = "";
-String emoncms_node = "";
-String emoncms_apikey = "";
-String emoncms_fingerprint = "";
-
-// MQTT Settings
-String mqtt_server = "";
-String mqtt_topic = "";
-String mqtt_user = "";
-String mqtt_pass = "";
-
-//Ohm Connect Settings
-String ohm = "";
-
-#define EEPROM_ESID_SIZE              32
-#define EEPROM_EPASS_SIZE             64
-#define EEPROM_EMON_API_KEY_SIZE      32
-#define EEPROM_EMON_SERVER_SIZE       45
-#define EEPROM_EMON_NODE_SIZE         32
-#define EEPROM_MQTT_SERVER_SIZE       45
-#define EEPROM_MQTT_TOPIC_SIZE        32
-#define EEPROM_MQTT_USER_SIZE         32
-#define EEPROM_MQTT_PASS_SIZE         64
-#define EEPROM_EMON_FINGERPRINT_SIZE  60
-#define EEPROM_WWW_USER_SIZE          16
-#define EEPROM_WWW_PASS_SIZE          16
-#define EEPROM_OHM_KEY_SIZE           8
+
+static ConfigSettings config_settings;
+const ConfigSettings &config = config_settings;
+
+uint32_t config_generation = 0;
+
+// Bit per ConfigField, changed since the last commit
+static uint32_t config_dirty = 0;
+static unsigned long config_dirty_time = 0;     // millis() of the first change
+static unsigned long config_change_time = 0;    // and the latest
+
+// Layout used with the EEPROM library, read once to move the settings
+// over to the config store
 #define EEPROM_SIZE                   512
 
-#define EEPROM_ESID_START             0
-#define EEPROM_ESID_END               (EEPROM_ESID_START + EEPROM_ESID_SIZE)
-#define EEPROM_EPASS_START            EEPROM_ESID_END
-#define EEPROM_EPASS_END              (EEPROM_EPASS_START + EEPROM_EPASS_SIZE)
-#define EEPROM_EMON_API_KEY_START     EEPROM_EPASS_END
-#define EEPROM_EMON_API_KEY_END       (EEPROM_EMON_API_KEY_START + EEPROM_EMON_API_KEY_SIZE)
-#define EEPROM_EMON_SERVER_START      EEPROM_EMON_API_KEY_END
-#define EEPROM_EMON_SERVER_END        (EEPROM_EMON_SERVER_START + EEPROM_EMON_SERVER_SIZE)
-#define EEPROM_EMON_NODE_START        EEPROM_EMON_SERVER_END
-#define EEPROM_EMON_NODE_END          (EEPROM_EMON_NODE_START + EEPROM_EMON_NODE_SIZE)
-#define EEPROM_MQTT_SERVER_START      EEPROM_EMON_NODE_END
-#define EEPROM_MQTT_SERVER_END        (EEPROM_MQTT_SERVER_START + EEPROM_MQTT_SERVER_SIZE)
-#define EEPROM_MQTT_TOPIC_START       EEPROM_MQTT_SERVER_END
-#define EEPROM_MQTT_TOPIC_END         (EEPROM_MQTT_TOPIC_START + EEPROM_MQTT_TOPIC_SIZE)
-#define EEPROM_MQTT_USER_START        EEPROM_MQTT_TOPIC_END
-#define EEPROM_MQTT_USER_END          (EEPROM_MQTT_USER_START + EEPROM_MQTT_USER_SIZE)
-#define EEPROM_MQTT_PASS_START        EEPROM_MQTT_USER_END
-#define EEPROM_MQTT_PASS_END          (EEPROM_MQTT_PASS_START + EEPROM_MQTT_PASS_SIZE)
-#define EEPROM_EMON_FINGERPRINT_START EEPROM_MQTT_PASS_END
-#define EEPROM_EMON_FINGERPRINT_END   (EEPROM_EMON_FINGERPRINT_START + EEPROM_EMON_FINGERPRINT_SIZE)
-#define EEPROM_WWW_USER_START         EEPROM_EMON_FINGERPRINT_END
-#define EEPROM_WWW_USER_END           (EEPROM_WWW_USER_START + EEPROM_WWW_USER_SIZE)
-#define EEPROM_WWW_PASS_START         EEPROM_WWW_USER_END
-#define EEPROM_WWW_PASS_END           (EEPROM_WWW_PASS_START + EEPROM_WWW_PASS_SIZE)
-#define EEPROM_OHM_KEY_START          EEPROM_WWW_PASS_END
-#define EEPROM_OHM_KEY_END            (EEPROM_OHM_KEY_START + EEPROM_OHM_KEY_SIZE)
+// Version of the layout below, bump if the meaning of a setting changes
+#define CONFIG_VERSION                1
 
 // -------------------------------------------------------------------
-// Reset EEPROM, wipes all settings
+// The settings as saved
+//
+// A record holds an id, length and the bytes of each setting that is
+// not at its default. Settings not in a record take their default and
+// ids not known are skipped, so settings can be added.
 // -------------------------------------------------------------------
-void
-ResetEEPROM() {
-  //DEBUG.println("Erasing EEPROM");
-  for (int i = 0; i < EEPROM_SIZE; ++i) {
-    EEPROM.write(i, 0);
-    //DEBUG.print("#");
-  }
-  EEPROM.commit();
+static const struct {
+  uint8_t id;
+  uint8_t size;                 // Longest value, the buffer is one more
+  uint8_t flags;
+  char *value;
+  const char *key;
+  const char *def;
+} config_fields[CONFIG_FIELDS] = {
+#define CONFIG_FIELD(name, key, id, size, flags, def) \
+  { id, size, flags, config_settings.name, key, def },
+  CONFIG_SETTINGS(CONFIG_FIELD)
+#undef CONFIG_FIELD
+};
+
+// Checks on the CONFIG_SETTINGS table
+#define CONFIG_CHECK(name, key, id, size, flags, def) \
+  static_assert(size > 0 && size <= 255, #name " is too long for a record"); \
+  static_assert(id > 0 && id <= 255, #name " needs an id from 1 to 255"); \
+  static_assert(sizeof(def) <= size + 1, #name " default is too long");
+CONFIG_SETTINGS(CONFIG_CHECK)
+#undef CONFIG_CHECK
+
+#define CONFIG_ID(name, key, id, size, flags, def) id,
+static constexpr uint8_t config_ids[] = { CONFIG_SETTINGS(CONFIG_ID) };
+#undef CONFIG_ID
+
+static constexpr bool
+config_ids_ascending(size_t i) {
+  return i + 1 >= CONFIG_FIELDS ||
+         (config_ids[i] < config_ids[i + 1] && config_ids_ascending(i + 1));
 }
+static_assert(config_ids_ascending(0), "Config ids must be unique and in order");
 
-void
-EEPROM_read_string(int start, int count, String & val) {
-  for (int i = 0; i < count; ++i) {
-    byte c = EEPROM.read(start + i);
-    if (c != 0 && c != 255)
-      val += (char) c;
+// Biggest record, two bytes of id and length then the value
+#define CONFIG_PACKED(name, key, id, size, flags, def) + 2 + size
+static_assert(0 CONFIG_SETTINGS(CONFIG_PACKED) <= CONFIG_STORE_DATA_SIZE,
+              "Settings too large for a config record");
+#undef CONFIG_PACKED
+
+#define CONFIG_LEGACY(name, key, id, size, flags, def) + (id <= CONFIG_LEGACY_ID ? size : 0)
+static_assert(0 CONFIG_SETTINGS(CONFIG_LEGACY) <= EEPROM_SIZE,
+              "Settings from EEPROM do not fit it");
+#undef CONFIG_LEGACY
+
+static_assert(CONFIG_FIELDS <= 32, "Too many settings for config_dirty");
+
+static void
+config_defaults() {
+  for (int f = 0; f < CONFIG_FIELDS; f++) {
+    strcpy(config_fields[f].value, config_fields[f].def);
   }
 }
 
-void
-EEPROM_write_string(int start, int count, String val) {
-  for (int i = 0; i < count; ++i) {
-    if (i < val.length()) {
-      EEPROM.write(start + i, val[i]);
-    } else {
-      EEPROM.write(start + i, 0);
+static void
+config_unpack(const uint8_t *data, int len) {
+  for (int i = 0; i + 2 <= len && i + 2 + data[i + 1] <= len; i += 2 + data[i + 1]) {
+    for (int f = 0; f < CONFIG_FIELDS; f++) {
+      if (data[i] == config_fields[f].id) {
+        size_t count = min(data[i + 1], config_fields[f].size);
+        memcpy(config_fields[f].value, data + i + 2, count);
+        config_fields[f].value[count] = '\0';
+      }
     }
   }
 }
 
-// -------------------------------------------------------------------
-// Load saved settings from EEPROM
-// -------------------------------------------------------------------
-void
-config_load_settings() {
-  EEPROM.begin(EEPROM_SIZE);
-
-  // Load WiFi values
-  EEPROM_read_string(EEPROM_ESID_START, EEPROM_ESID_SIZE, esid);
-  EEPROM_read_string(EEPROM_EPASS_START, EEPROM_EPASS_SIZE, epass);
-
-  // EmonCMS settings
-  EEPROM_read_string(EEPROM_EMON_API_KEY_START, EEPROM_EMON_API_KEY_SIZE,
-                     emoncms_apikey);
-  EEPROM_read_string(EEPROM_EMON_SERVER_START, EEPROM_EMON_SERVER_SIZE,
-                     emoncms_server);
-  EEPROM_read_string(EEPROM_EMON_NODE_START, EEPROM_EMON_NODE_SIZE,
-                     emoncms_node);
-  EEPROM_read_string(EEPROM_EMON_FINGERPRINT_START,
-                     EEPROM_EMON_FINGERPRINT_SIZE, emoncms_fingerprint);
-
-  // MQTT settings
-  EEPROM_read_string(EEPROM_MQTT_SERVER_START, EEPROM_MQTT_SERVER_SIZE,
-                     mqtt_server);
-  EEPROM_read_string(EEPROM_MQTT_TOPIC_START, EEPROM_MQTT_TOPIC_SIZE,
-                     mqtt_topic);
-  EEPROM_read_string(EEPROM_MQTT_USER_START, EEPROM_MQTT_USER_SIZE,
-                     mqtt_user);
-  EEPROM_read_string(EEPROM_MQTT_PASS_START, EEPROM_MQTT_PASS_SIZE,
-                     mqtt_pass);
-
-  // Web server credentials
-  EEPROM_read_string(EEPROM_WWW_USER_START, EEPROM_WWW_USER_SIZE,
-                     www_username);
-  EEPROM_read_string(EEPROM_WWW_PASS_START, EEPROM_WWW_PASS_SIZE,
-                     www_password);
-
-  //Ohm Connect Settings
-  EEPROM_read_string(EEPROM_OHM_KEY_START, EEPROM_OHM_KEY_SIZE, ohm);
+static int
+config_pack(uint8_t *data) {
+  int len = 0;
+  for (int f = 0; f < CONFIG_FIELDS; f++) {
+    if (0 != strcmp(config_fields[f].value, config_fields[f].def)) {
+      uint8_t count = strlen(config_fields[f].value);
+      data[len++] = config_fields[f].id;
+      data[len++] = count;
+      memcpy(data + len, config_fields[f].value, count);
+      len += count;
+    }
+  }
+  return len;
 }
 
-void
-config_save_emoncms(String server, String node, String apikey,
-                    String fingerprint) {
-  emoncms_server = server;
-  emoncms_node = node;
-  emoncms_apikey = apikey;
-  emoncms_fingerprint = fingerprint;
+// The EEPROM library wrote each setting as its characters padded out
+// with 0, bytes never written are 255. Anything else, such as a sector
+// left part erased by a brown out, is not taken as settings.
+static bool
+config_legacy_valid(const uint8_t *eeprom) {
+  int start = 0;
+  for (int f = 0; f < CONFIG_FIELDS && config_fields[f].id <= CONFIG_LEGACY_ID; f++) {
+    bool padding = false;
+    for (int i = 0; i < config_fields[f].size; i++) {
+      byte c = eeprom[start + i];
+      if (c == 0 || c == 255) {
+        padding = true;
+      } else if (padding || c < 0x20 || c == 0x7f) {
+        return false;
+      }
+    }
+    start += config_fields[f].size;
+  }
+  return true;
+}
 
-  // save apikey to EEPROM
-  EEPROM_write_string(EEPROM_EMON_API_KEY_START, EEPROM_EMON_API_KEY_SIZE,
-                      emoncms_apikey);
+// Read the settings as the EEPROM library left them
+static void
+config_load_legacy(const uint8_t *eeprom) {
+  int start = 0;
+  for (int f = 0; f < CONFIG_FIELDS && config_fields[f].id <= CONFIG_LEGACY_ID; f++) {
+    char *value = config_fields[f].value;
+    for (int i = 0; i < config_fields[f].size; i++) {
+      byte c = eeprom[start + i];
+      if (c != 0 && c != 255)
+        *value++ = (char) c;
+    }
+    *value = '\0';
+    start += config_fields[f].size;
+  }
+}
 
-  // save emoncms server to EEPROM max 45 characters
-  EEPROM_write_string(EEPROM_EMON_SERVER_START, EEPROM_EMON_SERVER_SIZE,
-                      emoncms_server);
+// Bring a record saved with an older layout up to CONFIG_VERSION, false
+// if it can not be. Add a case here when CONFIG_VERSION is bumped.
+static bool
+config_migrate(uint16_t version, uint8_t *data, int &len) {
+  switch (version) {
+    case CONFIG_VERSION:
+      return true;
+    default:
+      return false;
+  }
+}
 
-  // save emoncms node to EEPROM max 32 characters
-  EEPROM_write_string(EEPROM_EMON_NODE_START, EEPROM_EMON_NODE_SIZE,
-                      emoncms_node);
+static bool
+config_write() {
+  uint8_t data[CONFIG_STORE_DATA_SIZE];
+  int len = config_pack(data);
+  if (!config_store_write(data, len, CONFIG_VERSION)) {
+    // Keep the changes marked, config_loop() tries again after
+    // CONFIG_COMMIT_DELAY
+    DBUGLN("Config save failed");
+    config_dirty_time = config_change_time = millis();
+    return false;
+  }
+  config_dirty = 0;
+  return true;
+}
 
-  // save emoncms HTTPS fingerprint to EEPROM max 60 characters
-  EEPROM_write_string(EEPROM_EMON_FINGERPRINT_START,
-                      EEPROM_EMON_FINGERPRINT_SIZE, emoncms_fingerprint);
+// Change a setting, marking it to be written if it is different. Values
+// too long for the setting are cut short. Returns true if it changed.
+static bool
+config_set(int field, const char *value) {
+  char *setting = config_fields[field].value;
+  size_t size = config_fields[field].size + 1;
+  if (0 == strncmp(setting, value, size)) {
+    return false;
+  }
+  strlcpy(setting, value, size);
 
-  EEPROM.commit();
+  if (0 == config_dirty) {
+    config_dirty_time = millis();
+  }
+  config_dirty |= 1UL << field;
+  config_change_time = millis();
+  config_generation++;
+  return true;
 }
 
+// -------------------------------------------------------------------
+// Load saved settings
+// -------------------------------------------------------------------
 void
-config_save_mqtt(String server, String topic, String user, String pass) {
-  mqtt_server = server;
-  mqtt_topic = topic;
-  mqtt_user = user;
-  mqtt_pass = pass;
-
-  // Save MQTT server max 45 characters
-  EEPROM_write_string(EEPROM_MQTT_SERVER_START, EEPROM_MQTT_SERVER_SIZE,
-                      mqtt_server);
+config_load_settings() {
+  uint8_t data[CONFIG_STORE_DATA_SIZE];
+  uint16_t version;
+  config_defaults();
+  int len = config_store_read(data, sizeof(data), version);
+  if (len >= 0) {
+    if (!config_migrate(version, data, len)) {
+      // Likely saved by newer firmware, its settings may not mean the
+      // same here
+      DBUGF("Config version %u not supported, using defaults", version);
+      return;
+    }
+    config_unpack(data, len);
+    if (version != CONFIG_VERSION) {
+      config_write();
+    }
+  } else if (config_store_read_legacy(data, EEPROM_SIZE)) {
+    if (!config_legacy_valid(data)) {
+      DBUGLN("Config sector not valid, using defaults");
+      return;
+    }
+    DBUGLN("Moving settings from EEPROM");
+    config_load_legacy(data);
+    config_write();
+  }
+}
 
-  // Save MQTT topic max 32 characters
-  EEPROM_write_string(EEPROM_MQTT_TOPIC_START, EEPROM_MQTT_TOPIC_SIZE,
-                      mqtt_topic);
+bool
+config_commit() {
+  return 0 == config_dirty || config_write();
+}
 
-  // Save MQTT username max 32 characters
-  EEPROM_write_string(EEPROM_MQTT_USER_START, EEPROM_MQTT_USER_SIZE,
-                      mqtt_user);
+void
+config_loop() {
+  if (0 != config_dirty &&
+      ((millis() - config_change_time) >= CONFIG_COMMIT_DELAY ||
+       (millis() - config_dirty_time) >= CONFIG_COMMIT_MAX_DELAY)) {
+    config_write();
+  }
+}
 
-  // Save MQTT pass max 64 characters
-  EEPROM_write_string(EEPROM_MQTT_PASS_START, EEPROM_MQTT_PASS_SIZE,
-                      mqtt_pass);
+void
+config_save_emoncms(const char *server, const char *node, const char *apikey,
+                    const char *fingerprint) {
+  config_set(CONFIG_emoncms_server, server);
+  config_set(CONFIG_emoncms_node, node);
+  config_set(CONFIG_emoncms_apikey, apikey);
+  config_set(CONFIG_emoncms_fingerprint, fingerprint);
+}
 
-  EEPROM.commit();
+void
+config_save_mqtt(const char *server, const char *topic, const char *user,
+                 const char *pass) {
+  config_set(CONFIG_mqtt_server, server);
+  config_set(CONFIG_mqtt_topic, topic);
+  config_set(CONFIG_mqtt_user, user);
+  config_set(CONFIG_mqtt_pass, pass);
 }
 
 void
-config_save_admin(String user, String pass) {
-  www_username = user;
-  www_password = pass;
+config_save_admin(const char *user, const char *pass) {
+  config_set(CONFIG_www_username, user);
+  config_set(CONFIG_www_password, pass);
+}
 
-  EEPROM_write_string(EEPROM_WWW_USER_START, EEPROM_WWW_USER_SIZE, user);
-  EEPROM_write_string(EEPROM_WWW_PASS_START, EEPROM_WWW_PASS_SIZE, pass);
+void
+config_save_wifi(const char *qsid, const char *qpass) {
+  config_set(CONFIG_esid, qsid);
+  config_set(CONFIG_epass, qpass);
+}
 
-  EEPROM.commit();
+void
+config_save_ohm(const char *qohm) {
+  config_set(CONFIG_ohm_key, qohm);
 }
 
+// -------------------------------------------------------------------
+// JSON
+// -------------------------------------------------------------------
 void
-config_save_wifi(String qsid, String qpass) {
-  esid = qsid;
-  epass = qpass;
+config_write_json(JsonWriter &json) {
+  for (int f = 0; f < CONFIG_FIELDS; f++) {
+    if (0 == (config_fields[f].flags & CONFIG_SECRET)) {
+      json.member(config_fields[f].key, (const char *)config_fields[f].value);
+    }
+  }
+}
 
-  EEPROM_write_string(EEPROM_ESID_START, EEPROM_ESID_SIZE, qsid);
-  EEPROM_write_string(EEPROM_EPASS_START, EEPROM_EPASS_SIZE, qpass);
+static int
+config_find(const char *key) {
+  for (int f = 0; f < CONFIG_FIELDS; f++) {
+    if (0 == strcmp(key, config_fields[f].key)) {
+      return f;
+    }
+  }
+  return -1;
+}
 
-  EEPROM.commit();
+// Read the object, setting the values only if apply is set, false if
+// it is not valid
+static bool
+config_read_json(const char *json, size_t len, bool apply, uint32_t &changed) {
+  JsonReader reader;
+  json_reader_init(reader, json, len);
+  if (!json_expect(reader, '{')) {
+    return false;
+  }
+  if (!json_expect(reader, '}')) {
+    do {
+      char key[24];
+      char value[256];
+      if (json_read_string(reader, key, sizeof(key)) < 0 ||
+          !json_expect(reader, ':') ||
+          json_read_string(reader, value, sizeof(value)) < 0) {
+        return false;
+      }
+
+      int field = config_find(key);
+      if (field < 0 || strlen(value) > config_fields[field].size) {
+        DBUGF("Config %s not known or too long", key);
+        return false;
+      }
+      if (apply && config_set(field, value)) {
+        changed |= 1UL << field;
+      }
+    } while (json_expect(reader, ','));
+    if (!json_expect(reader, '}')) {
+      return false;
+    }
+  }
+  return json_at_end(reader);
 }
 
-void
-config_save_ohm(String qohm) {
-  ohm = qohm;
+bool
+config_set_json(const char *json, size_t len, uint32_t &changed) {
+  changed = 0;
+  return config_read_json(json, len, false, changed) &&
+         config_read_json(json, len, true, changed);
+}
 
-  EEPROM_write_string(EEPROM_OHM_KEY_START, EEPROM_OHM_KEY_SIZE, qohm);
+uint8_t
+config_flags(uint32_t fields) {
+  uint8_t flags = 0;
+  for (int f = 0; f < CONFIG_FIELDS; f++) {
+    if (fields & (1UL << f)) {
+      flags |= config_fields[f].flags;
+    }
+  }
+  return flags;
+}
 
-  EEPROM.commit();
+const char *
+config_key(int field) {
+  return config_fields[field].key;
 }
 
+// -------------------------------------------------------------------
+// Wipes all settings
+// -------------------------------------------------------------------
 void
 config_reset() {
-  ResetEEPROM();
+  config_store_erase();
+  config_dirty = 0;
+  config_generation++;
 }
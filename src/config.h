@@ -3,41 +3,123 @@
 
 #include <Arduino.h>
 
-// Global config varables
+// -------------------------------------------------------------------
+// The settings, one line each:
+//
+//   X(name, key, id, size, flags, default)
+//
+//   name     ConfigSettings member, read with config_<name>()
+//   key      in the /config JSON
+//   id       in the saved record, never reuse one
+//   size     longest value
+//   flags    CONFIG_SECRET to never send it back, and the CONFIG_WIFI
+//            etc. that use it
+//   default  until it is saved
+//
+// Keep the lines in id order. Ids up to CONFIG_LEGACY_ID are also read
+// from the EEPROM layout of older firmware, where each took size bytes
+// in id order.
+// -------------------------------------------------------------------
+#define CONFIG_SETTINGS(X) \
+  X(esid,                 "ssid",                 1,  32, CONFIG_WIFI,                    "") \
+  X(epass,                "pass",                 2,  64, CONFIG_WIFI | CONFIG_SECRET,    "") \
+  X(emoncms_apikey,       "emoncms_apikey",       3,  32, CONFIG_EMONCMS | CONFIG_SECRET, "") \
+  X(emoncms_server,       "emoncms_server",       4,  45, CONFIG_EMONCMS,                 "") \
+  X(emoncms_node,         "emoncms_node",         5,  32, CONFIG_EMONCMS,                 "") \
+  X(mqtt_server,          "mqtt_server",          6,  45, CONFIG_MQTT,                    "") \
+  X(mqtt_topic,           "mqtt_topic",           7,  32, CONFIG_MQTT,                    "") \
+  X(mqtt_user,            "mqtt_user",            8,  32, CONFIG_MQTT,                    "") \
+  X(mqtt_pass,            "mqtt_pass",            9,  64, CONFIG_MQTT | CONFIG_SECRET,    "") \
+  X(emoncms_fingerprint,  "emoncms_fingerprint",  10, 60, CONFIG_EMONCMS,                 "") \
+  X(www_username,         "www_username",         11, 16, CONFIG_WWW,                     "") \
+  X(www_password,         "www_password",         12, 16, CONFIG_WWW | CONFIG_SECRET,     "") \
+  X(ohm_key,              "ohmkey",               13, 8,  CONFIG_SECRET,                  "")
+
+// Flags
+#define CONFIG_SECRET     0x01
+// What has to be restarted when the setting changes
+#define CONFIG_WIFI       0x02
+#define CONFIG_EMONCMS    0x04
+#define CONFIG_MQTT       0x08
+#define CONFIG_WWW        0x10
+
+#define CONFIG_LEGACY_ID  13
 
-// Wifi Network Strings
-extern String esid;
-extern String epass;
+// Index of each setting, CONFIG_esid etc.
+#define CONFIG_ENUM(name, key, id, size, flags, def) CONFIG_##name,
+enum ConfigField {
+  CONFIG_SETTINGS(CONFIG_ENUM)
+  CONFIG_FIELDS
+};
+#undef CONFIG_ENUM
 
-// Web server authentication (leave blank for none)
-extern String www_username;
-extern String www_password;
+// Each nul terminated
+#define CONFIG_MEMBER(name, key, id, size, flags, def) char name[size + 1];
+struct ConfigSettings {
+  CONFIG_SETTINGS(CONFIG_MEMBER)
+};
+#undef CONFIG_MEMBER
 
-// EMONCMS SERVER strings
-extern String emoncms_server;
-extern String emoncms_node;
-extern String emoncms_apikey;
-extern String emoncms_fingerprint;
+// Read only, change them with config_save_*() or config_set_json()
+extern const ConfigSettings &config;
 
-// MQTT Settings
-extern String mqtt_server;
-extern String mqtt_topic;
-extern String mqtt_user;
-extern String mqtt_pass;
+#define CONFIG_ACCESSOR(name, key, id, size, flags, def) \
+  inline const char *config_##name() { return config.name; }
+CONFIG_SETTINGS(CONFIG_ACCESSOR)
+#undef CONFIG_ACCESSOR
 
-//Ohm Connect Settings
-extern String ohm;
+// Bumped each time the settings change
+extern uint32_t config_generation;
 
 // -------------------------------------------------------------------
 // Load saved settings from config
 // -------------------------------------------------------------------
 extern void config_load_settings();
 
-extern void config_save_emoncms(String server, String node, String apikey, String fingerprint);
-extern void config_save_mqtt(String server, String topic, String user, String pass);
-extern void config_save_admin(String user, String pass);
-extern void config_save_wifi(String qsid, String qpass);
-extern void config_save_ohm(String qohm);
+// -------------------------------------------------------------------
+// Saving
+//
+// The config_save_*() functions only change the settings in RAM and
+// mark those that differ from what was saved. config_loop() writes them
+// to flash once nothing has changed for CONFIG_COMMIT_DELAY ms, or
+// CONFIG_COMMIT_MAX_DELAY ms after the first change, so several saves
+// close together take one flash write.
+// -------------------------------------------------------------------
+#define CONFIG_COMMIT_DELAY       2000
+#define CONFIG_COMMIT_MAX_DELAY   10000
+
+extern void config_loop();
+
+// Write any changes now, e.g. before a restart. False if the write
+// failed, the changes stay marked for config_loop() to retry.
+extern bool config_commit();
+
+extern void config_save_emoncms(const char *server, const char *node, const char *apikey,
+                                const char *fingerprint);
+extern void config_save_mqtt(const char *server, const char *topic, const char *user,
+                             const char *pass);
+extern void config_save_admin(const char *user, const char *pass);
+extern void config_save_wifi(const char *qsid, const char *qpass);
+extern void config_save_ohm(const char *qohm);
+
+class JsonWriter;
+
+// Write the settings as members of the current object, leaving out the
+// secrets
+extern void config_write_json(JsonWriter &json);
+
+// Set the settings named in a JSON object of strings, e.g.
+// {"ssid":"home","pass":"secret"}. Nothing is changed unless all of it
+// is valid, returns false if it is not. changed has a bit set for each
+// ConfigField that now differs.
+extern bool config_set_json(const char *json, size_t len, uint32_t &changed);
+
+// Flags of the ConfigFields with a bit set in fields, e.g. CONFIG_MQTT
+// if any MQTT setting is in them
+extern uint8_t config_flags(uint32_t fields);
+
+// JSON key of a ConfigField
+extern const char *config_key(int field);
 
 extern void config_reset();
 
@@ -0,0 +1,252 @@
+#include "emonesp.h"
+#include "config_store.h"
+#include "debug.h"
+
+#include <Arduino.h>
+#include <FS.h>
+
+// The sector after SPIFFS, as used by the EEPROM library
+extern "C" uint32_t _SPIFFS_end;
+
+#define CONFIG_STORE_MAGIC    0x4e45504fUL    // "OPEN"
+
+struct ConfigRecord {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t length;
+  uint32_t sequence;
+  uint32_t crc;
+};
+
+#define CONFIG_RECORD_SIZE(length)  ((sizeof(ConfigRecord) + (length) + 3) & ~3)
+
+// Words so it can be handed straight to the flash functions
+static uint32_t store_buf[CONFIG_RECORD_SIZE(CONFIG_STORE_DATA_SIZE) / 4];
+static ConfigRecord *const store_record = (ConfigRecord *)store_buf;
+
+static uint32_t store_end = CONFIG_STORE_SIZE;  // Offset of the next record,
+                                                // CONFIG_STORE_SIZE to erase first
+static uint32_t store_sequence = 0;
+static uint32_t store_record_size = 0;          // Of the newest record
+static bool store_scanned = false;
+static ConfigStoreStats store_stats;
+
+static uint32_t
+store_address() {
+  return (uint32_t)(uintptr_t)&_SPIFFS_end - 0x40200000;
+}
+
+static uint32_t
+store_crc(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (int i = 0; i < 8; i++) {
+      crc = (crc >> 1) ^ (0xedb88320UL & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+static uint32_t
+store_record_crc() {
+  uint32_t crc = store_crc(0, (const uint8_t *)store_record,
+                           offsetof(ConfigRecord, crc));
+  return store_crc(crc, (const uint8_t *)(store_record + 1), store_record->length);
+}
+
+// true if the flash from start to end has not been written since the
+// last erase
+static bool
+store_erased(uint32_t start, uint32_t end) {
+  uint32_t words[16];
+  for (uint32_t offset = start; offset < end; offset += sizeof(words)) {
+    size_t len = min(sizeof(words), end - offset);
+    ESP.flashRead(store_address() + offset, words, len);
+    for (size_t i = 0; i < len / 4; i++) {
+      if (0xffffffff != words[i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Read the record at offset into store_buf, false if there is not one
+static bool
+store_read_record(uint32_t offset) {
+  ESP.flashRead(store_address() + offset, store_buf, sizeof(ConfigRecord));
+  if (CONFIG_STORE_MAGIC != store_record->magic ||
+      store_record->length > CONFIG_STORE_DATA_SIZE ||
+      offset + CONFIG_RECORD_SIZE(store_record->length) > CONFIG_STORE_SIZE) {
+    return false;
+  }
+  ESP.flashRead(store_address() + offset + sizeof(ConfigRecord),
+                store_buf + sizeof(ConfigRecord) / 4,
+                CONFIG_RECORD_SIZE(store_record->length) - sizeof(ConfigRecord));
+  return true;
+}
+
+// -------------------------------------------------------------------
+// Find the newest good record and where the next one goes, returns the
+// offset of the record or -1 if there is none
+// -------------------------------------------------------------------
+static int
+store_scan() {
+  int newest = -1;
+  uint32_t offset = 0;
+
+  store_scanned = true;
+  store_end = CONFIG_STORE_SIZE;
+  while (offset + sizeof(ConfigRecord) <= CONFIG_STORE_SIZE) {
+    if (!store_read_record(offset)) {
+      if (0xffffffff == store_record->magic) {
+        store_end = offset;
+      }
+      break;
+    }
+    if (store_record_crc() == store_record->crc) {
+      newest = offset;
+      store_record_size = CONFIG_RECORD_SIZE(store_record->length);
+    }
+    store_sequence = max(store_sequence, store_record->sequence);
+    offset += CONFIG_RECORD_SIZE(store_record->length);
+  }
+
+  // Anything after the last record, e.g. a torn header, has to be
+  // erased before another record can go there
+  if (store_end < CONFIG_STORE_SIZE && !store_erased(store_end, CONFIG_STORE_SIZE)) {
+    store_end = CONFIG_STORE_SIZE;
+  }
+  return newest;
+}
+
+// The sector was last written by the EEPROM library
+static bool
+store_is_legacy() {
+  uint32_t magic;
+  ESP.flashRead(store_address(), &magic, sizeof(magic));
+  return CONFIG_STORE_MAGIC != magic &&
+         !store_erased(0, CONFIG_STORE_LEGACY_SIZE);
+}
+
+static bool
+store_read_backup() {
+  File file = SPIFFS.open(CONFIG_STORE_BACKUP, "r");
+  if (!file) {
+    return false;
+  }
+  size_t len = file.read((uint8_t *)store_buf, sizeof(store_buf));
+  file.close();
+
+  if (len < sizeof(ConfigRecord) || CONFIG_STORE_MAGIC != store_record->magic ||
+      store_record->length > len - sizeof(ConfigRecord) ||
+      store_record_crc() != store_record->crc) {
+    return false;
+  }
+  store_sequence = max(store_sequence, store_record->sequence);
+  return true;
+}
+
+// Write the record in store_buf at offset, erasing the sector first if
+// asked to
+static bool
+store_flash(uint32_t offset, size_t size, bool erase) {
+  unsigned long start = micros();
+  noInterrupts();
+  bool ok = (!erase || ESP.flashEraseSector(store_address() / CONFIG_STORE_SIZE)) &&
+            ESP.flashWrite(store_address() + offset, store_buf, size);
+  interrupts();
+
+  store_stats.commits++;
+  if (erase) {
+    store_stats.erases++;
+  }
+  store_stats.commit_time = micros() - start;
+  store_record_size = size;
+  store_end = ok ? offset + size : CONFIG_STORE_SIZE;
+  return ok;
+}
+
+int
+config_store_read(uint8_t *data, size_t size, uint16_t &version) {
+  SPIFFS.begin();
+
+  int offset = store_scan();
+  if (offset >= 0) {
+    store_read_record(offset);
+  } else if (!store_read_backup()) {
+    // A backup is only written once records are in use, so whatever is
+    // in the sector is not trusted over one, it may be torn
+    return -1;
+  } else {
+    DBUGLN("Config loaded from backup");
+  }
+
+  version = store_record->version;
+  size_t length = min((size_t)store_record->length, size);
+  memcpy(data, store_record + 1, length);
+  return length;
+}
+
+bool
+config_store_write(const uint8_t *data, size_t length, uint16_t version) {
+  if (length > CONFIG_STORE_DATA_SIZE) {
+    return false;
+  }
+  if (!store_scanned) {
+    store_scan();
+  }
+
+  size_t size = CONFIG_RECORD_SIZE(length);
+  store_record->magic = CONFIG_STORE_MAGIC;
+  store_record->version = version;
+  store_record->length = length;
+  store_record->sequence = ++store_sequence;
+  memcpy(store_record + 1, data, length);
+  memset((uint8_t *)(store_record + 1) + length, 0xff,
+         size - sizeof(ConfigRecord) - length);
+  store_record->crc = store_record_crc();
+
+  if (store_end + size <= CONFIG_STORE_SIZE && store_flash(store_end, size, false)) {
+    return true;
+  }
+
+  // Full, start the sector again with just this record
+  DBUGLN("Config sector full, erasing");
+  File file = SPIFFS.open(CONFIG_STORE_BACKUP, "w");
+  if (file) {
+    file.write((const uint8_t *)store_buf, size);
+    file.close();
+  }
+  return store_flash(0, size, true);
+}
+
+bool
+config_store_read_legacy(uint8_t *data, size_t size) {
+  if (!store_is_legacy()) {
+    return false;
+  }
+  size = min(size, (size_t)CONFIG_STORE_LEGACY_SIZE);
+  ESP.flashRead(store_address(), store_buf, CONFIG_STORE_LEGACY_SIZE);
+  memcpy(data, store_buf, size);
+  return true;
+}
+
+void
+config_store_erase() {
+  noInterrupts();
+  ESP.flashEraseSector(store_address() / CONFIG_STORE_SIZE);
+  interrupts();
+  store_stats.erases++;
+  store_scanned = true;
+  store_end = 0;
+  SPIFFS.remove(CONFIG_STORE_BACKUP);
+}
+
+const ConfigStoreStats &
+config_store_stats() {
+  store_stats.erase_estimate =
+    (store_sequence * store_record_size + CONFIG_STORE_SIZE - 1) / CONFIG_STORE_SIZE;
+  return store_stats;
+}
@@ -0,0 +1,56 @@
+#ifndef _EMONESP_CONFIG_STORE_H
+#define _EMONESP_CONFIG_STORE_H
+
+#include <Arduino.h>
+
+// -------------------------------------------------------------------
+// Config records in the flash sector the EEPROM library used
+//
+// Each save appends a record to the sector:
+//
+//   magic     "OPEN"
+//   version   layout of the data, CONFIG_VERSION in config.cpp
+//   length    bytes of data
+//   sequence  one more than the record before
+//   crc       CRC32 of the above and the data
+//   data      padded to a multiple of 4 bytes
+//
+// Flash only needs erasing once the sector is full, rather than on
+// every save as with EEPROM.commit(). Before erasing, the new record is
+// written to CONFIG_STORE_BACKUP in SPIFFS so a brown out part way
+// through still leaves a good copy.
+//
+// At boot the newest record with a good CRC is loaded. A record torn
+// by a brown out is skipped in favour of the one before it.
+// -------------------------------------------------------------------
+#define CONFIG_STORE_SIZE         4096      // One flash sector
+#define CONFIG_STORE_DATA_SIZE    512       // Most bytes of data
+#define CONFIG_STORE_LEGACY_SIZE  512       // EEPROM bytes used before
+#define CONFIG_STORE_BACKUP       "/config.bak"
+
+// Read the newest good record into data, from CONFIG_STORE_BACKUP if
+// the sector has none, returns its length or -1 if there is none
+extern int config_store_read(uint8_t *data, size_t size, uint16_t &version);
+
+// Save a new record, false on a flash error
+extern bool config_store_write(const uint8_t *data, size_t length, uint16_t version);
+
+// Read the settings saved with the EEPROM library, false if the sector
+// is blank or holds records. Only worth trying when config_store_read()
+// found nothing, and the data may be any garbage a brown out left.
+extern bool config_store_read_legacy(uint8_t *data, size_t size);
+
+// Wipe the saved settings
+extern void config_store_erase();
+
+struct ConfigStoreStats {
+  uint32_t commits;             // Records written since boot
+  uint32_t erases;              // Sector erases since boot
+  uint32_t commit_time;         // us the last record took to write
+  uint32_t erase_estimate;      // Erases over the life of the sector,
+                                // from the records written
+};
+
+extern const ConfigStoreStats &config_store_stats();
+
+#endif // _EMONESP_CONFIG_STORE_H
@@ -0,0 +1,346 @@
+#include "emonesp.h"
+#include "datalog.h"
+#include "input.h"
+#include "debug.h"
+
+#include <Arduino.h>
+#include <FS.h>
+
+#define DATALOG_DIR           "/tl/"
+#define DATALOG_MAGIC         "TLG1"
+#define DATALOG_HEADER_SIZE   16
+#define DATALOG_MAX_RECORD    (5 + DATALOG_FIELDS * 5)
+
+static const struct {
+  const char *name;
+  int scale;                    // Stored value * scale is the real value
+} datalog_fields[DATALOG_FIELDS] = {
+  { "amp", 10 },                // mA, logged as 10 mA
+  { "pilot", 1 },
+  { "temp1", 1 },
+  { "temp2", 1 },
+  { "temp3", 1 },
+  { "state", 1 }
+};
+
+// Segments held in flash, first to last inclusive, 0 if none
+static uint32_t datalog_first = 0;
+static uint32_t datalog_last = 0;
+static size_t datalog_total = 0;          // Bytes in all segments
+
+static uint32_t datalog_boot = 0;         // First segment of this boot
+static uint32_t datalog_segment = 0;      // Segment being written
+static size_t datalog_segment_size = 0;   // Bytes written and buffered
+static bool datalog_header_written = false;
+static uint32_t datalog_segment_uptime = 0;  // Uptime in the header
+static uint32_t datalog_record_uptime = 0;   // Uptime of the last record in the segment
+
+static uint8_t datalog_buf[DATALOG_BATCH_SIZE];
+static int datalog_buf_len = 0;
+
+static bool datalog_started = false;
+static unsigned long datalog_next_time = 0;     // millis() of the next record
+static unsigned long datalog_flush_time = 0;    // millis() of the last flush
+static unsigned long datalog_last_millis = 0;
+static uint32_t datalog_uptime = 0;             // s since boot of the last record
+static long datalog_values[DATALOG_FIELDS];     // Last record written
+
+const char *
+datalog_field_name(int field) {
+  return datalog_fields[field].name;
+}
+
+static void
+datalog_segment_name(uint32_t segment, char *name, int size) {
+  snprintf(name, size, DATALOG_DIR "%08x", segment);
+}
+
+static int
+datalog_put_varint(uint8_t *out, uint32_t value) {
+  int len = 0;
+  do {
+    uint8_t byte = value & 0x7F;
+    value >>= 7;
+    out[len++] = value ? byte | 0x80 : byte;
+  } while (value);
+  return len;
+}
+
+static void
+datalog_put_uint32(uint8_t *out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out[i] = value >> (8 * i);
+  }
+}
+
+static uint32_t
+datalog_get_uint32(const uint8_t *in) {
+  return in[0] | (in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// -------------------------------------------------------------------
+// Remove the oldest segments until the log fits its budget and SPIFFS
+// has room for another segment
+// -------------------------------------------------------------------
+static void
+datalog_trim() {
+  while (datalog_first && datalog_first < datalog_segment) {
+    FSInfo info;
+    SPIFFS.info(info);
+    if (datalog_total <= DATALOG_BUDGET &&
+        info.totalBytes - info.usedBytes >= DATALOG_SEGMENT_SIZE) {
+      break;
+    }
+
+    char name[16];
+    datalog_segment_name(datalog_first, name, sizeof(name));
+    File file = SPIFFS.open(name, "r");
+    if (file) {
+      datalog_total -= min(datalog_total, file.size());
+      file.close();
+      SPIFFS.remove(name);
+    }
+    DBUGF("Datalog removed %s", name);
+    datalog_first++;
+  }
+}
+
+void
+datalog_flush() {
+  if (0 == datalog_buf_len) {
+    return;
+  }
+
+  char name[16];
+  datalog_segment_name(datalog_segment, name, sizeof(name));
+  File file = SPIFFS.open(name, "a");
+  if (!file) {
+    DBUGF("Datalog can not open %s", name);
+    datalog_buf_len = 0;
+    return;
+  }
+
+  if (!datalog_header_written) {
+    // Written with the first batch so the clock has been read
+    uint8_t header[DATALOG_HEADER_SIZE];
+    uint32_t now = input_time();
+    uint32_t uptime = datalog_uptime + (millis() - datalog_last_millis) / 1000;
+    memcpy(header, DATALOG_MAGIC, 4);
+    datalog_put_uint32(header + 4, datalog_boot);
+    datalog_put_uint32(header + 8, datalog_segment_uptime);
+    datalog_put_uint32(header + 12, now ? now - (uptime - datalog_segment_uptime) : 0);
+    file.write(header, sizeof(header));
+    datalog_total += sizeof(header);
+    datalog_header_written = true;
+    if (0 == datalog_first) {
+      datalog_first = datalog_segment;
+    }
+    datalog_last = datalog_segment;
+  }
+
+  file.write(datalog_buf, datalog_buf_len);
+  file.close();
+  datalog_total += datalog_buf_len;
+  datalog_buf_len = 0;
+  datalog_flush_time = millis();
+
+  datalog_trim();
+}
+
+static void
+datalog_start_segment() {
+  datalog_flush();
+  datalog_segment++;
+  datalog_segment_size = DATALOG_HEADER_SIZE;
+  datalog_header_written = false;
+  datalog_segment_uptime = datalog_uptime;
+  datalog_record_uptime = datalog_uptime;
+  memset(datalog_values, 0, sizeof(datalog_values));
+}
+
+static void
+datalog_record(const EvseTelemetry &evse) {
+  unsigned long now = millis();
+  datalog_uptime += (now - datalog_last_millis) / 1000;
+  datalog_last_millis = now - (now - datalog_last_millis) % 1000;
+
+  if (datalog_segment_size + DATALOG_MAX_RECORD > DATALOG_SEGMENT_SIZE) {
+    datalog_start_segment();
+  }
+
+  const long values[DATALOG_FIELDS] = {
+    evse.amp / 10, evse.pilot, evse.temp1, evse.temp2, evse.temp3, evse.state
+  };
+
+  uint8_t record[DATALOG_MAX_RECORD];
+  int len = datalog_put_varint(record, datalog_uptime - datalog_record_uptime);
+  datalog_record_uptime = datalog_uptime;
+  for (int i = 0; i < DATALOG_FIELDS; i++) {
+    int32_t delta = values[i] - datalog_values[i];
+    len += datalog_put_varint(record + len, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+    datalog_values[i] = values[i];
+  }
+
+  if (datalog_buf_len + len > DATALOG_BATCH_SIZE) {
+    datalog_flush();
+  }
+  memcpy(datalog_buf + datalog_buf_len, record, len);
+  datalog_buf_len += len;
+  datalog_segment_size += len;
+}
+
+// -------------------------------------------------------------------
+// Find the segments left by earlier boots, this boot starts a new one
+// -------------------------------------------------------------------
+void
+datalog_setup() {
+  Dir dir = SPIFFS.openDir(DATALOG_DIR);
+  while (dir.next()) {
+    uint32_t segment = strtoul(dir.fileName().c_str() + strlen(DATALOG_DIR), NULL, 16);
+    if (segment) {
+      datalog_first = datalog_first && datalog_first < segment ? datalog_first : segment;
+      datalog_last = max(datalog_last, segment);
+      datalog_total += dir.fileSize();
+    }
+  }
+
+  datalog_segment = datalog_last;
+  datalog_start_segment();
+  datalog_boot = datalog_segment;
+  DBUGF("Datalog %u bytes in segments %u to %u", datalog_total, datalog_first, datalog_last);
+}
+
+// -------------------------------------------------------------------
+// Call every time around loop()
+// -------------------------------------------------------------------
+void
+datalog_loop() {
+  unsigned long now = millis();
+  if (!datalog_started) {
+    // Wait for the OpenEVSE
+    EvseTelemetry evse;
+    input_snapshot(evse);
+    if (0 == evse.state) {
+      return;
+    }
+    datalog_started = true;
+    datalog_next_time = now;
+    datalog_flush_time = now;
+    datalog_last_millis = now;
+    datalog_uptime = now / 1000;
+    datalog_segment_uptime = datalog_uptime;
+    datalog_record_uptime = datalog_uptime;
+  }
+
+  if ((long)(now - datalog_next_time) >= 0) {
+    EvseTelemetry evse;
+    input_snapshot(evse);
+    datalog_record(evse);
+    datalog_next_time += DATALOG_INTERVAL;
+    if ((long)(now - datalog_next_time) >= 0) {
+      // Held up for more than an interval, carry on from now
+      datalog_next_time = now + DATALOG_INTERVAL;
+    }
+  }
+
+  if (datalog_buf_len > 0 && (now - datalog_flush_time) >= DATALOG_FLUSH_TIME) {
+    datalog_flush();
+  }
+}
+
+// -------------------------------------------------------------------
+// Log reader
+// -------------------------------------------------------------------
+DatalogReader::DatalogReader() :
+  segment(datalog_first), len(0), pos(0)
+{
+}
+
+int
+DatalogReader::read_byte() {
+  if (pos == len) {
+    if (!file) {
+      return -1;
+    }
+    len = file.read(buf, sizeof(buf));
+    pos = 0;
+    if (len <= 0) {
+      len = 0;
+      return -1;
+    }
+  }
+  return buf[pos++];
+}
+
+bool
+DatalogReader::read_varint(uint32_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    int byte = read_byte();
+    if (byte < 0) {
+      return false;
+    }
+    value |= (uint32_t)(byte & 0x7F) << shift;
+    if (0 == (byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+DatalogReader::open_next() {
+  if (file) {
+    file.close();
+  }
+  while (segment && segment <= datalog_last) {
+    char name[16];
+    datalog_segment_name(segment++, name, sizeof(name));
+    file = SPIFFS.open(name, "r");
+    if (!file) {
+      continue;
+    }
+
+    uint8_t header[DATALOG_HEADER_SIZE];
+    len = pos = 0;
+    if (file.read(header, sizeof(header)) == sizeof(header) &&
+        0 == memcmp(header, DATALOG_MAGIC, 4)) {
+      boot = datalog_get_uint32(header + 4);
+      start_uptime = uptime = datalog_get_uint32(header + 8);
+      start_time = datalog_get_uint32(header + 12);
+      memset(values, 0, sizeof(values));
+      return true;
+    }
+    file.close();
+  }
+  return false;
+}
+
+bool
+DatalogReader::next(DatalogRecord &record) {
+  uint32_t dt;
+  while (!file || !read_varint(dt)) {
+    if (!open_next()) {
+      return false;
+    }
+  }
+
+  uptime += dt;
+  for (int i = 0; i < DATALOG_FIELDS; i++) {
+    uint32_t zigzag;
+    if (!read_varint(zigzag)) {
+      // Cut short by a restart part way through a write
+      file.close();
+      return next(record);
+    }
+    values[i] += (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+  }
+
+  record.boot = boot;
+  record.uptime = uptime;
+  record.time = start_time ? start_time + (uptime - start_uptime) : 0;
+  for (int i = 0; i < DATALOG_FIELDS; i++) {
+    record.values[i] = values[i] * datalog_fields[i].scale;
+  }
+  return true;
+}
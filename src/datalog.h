@@ -0,0 +1,81 @@
+#ifndef _EMONESP_DATALOG_H
+#define _EMONESP_DATALOG_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+// -------------------------------------------------------------------
+// Telemetry log
+//
+// A rolling log of the telemetry in SPIFFS that survives loss of the
+// network and restarts. A record is taken every DATALOG_INTERVAL ms and
+// held in RAM until DATALOG_BATCH_SIZE bytes have built up or
+// DATALOG_FLUSH_TIME has passed, then appended to the current segment
+// file. Segments are started at boot and every DATALOG_SEGMENT_SIZE
+// bytes; the oldest are removed to keep the log within DATALOG_BUDGET.
+//
+// Segment files are /tl/<number in hex>:
+//
+//   header  "TLG1", boot, uptime, time    little endian uint32s
+//   record  dt, then a delta for each field
+//
+// dt is the seconds since the previous record (or the header uptime),
+// a field delta is the change from the previous record (or 0), both as
+// LEB128 varints, deltas zigzag encoded. boot is the number of the
+// first segment written since that boot, time the Unix time at uptime
+// or 0 if the OpenEVSE has no clock.
+// -------------------------------------------------------------------
+#ifndef DATALOG_INTERVAL
+#define DATALOG_INTERVAL      60000           // ms between records
+#endif
+#ifndef DATALOG_BUDGET
+#define DATALOG_BUDGET        (128 * 1024)    // Flash used by the log
+#endif
+#define DATALOG_SEGMENT_SIZE  (8 * 1024)
+#define DATALOG_BATCH_SIZE    256
+#define DATALOG_FLUSH_TIME    (15 * 60000)
+
+#define DATALOG_FIELDS        6
+
+struct DatalogRecord {
+  uint32_t boot;
+  uint32_t uptime;              // s since boot
+  uint32_t time;                // Unix time, 0 if not known
+  long values[DATALOG_FIELDS];  // In the same units as /rapiupdate
+};
+
+extern const char *datalog_field_name(int field);
+
+// -------------------------------------------------------------------
+// Reads the log from the oldest record without loading whole segments
+// -------------------------------------------------------------------
+class DatalogReader {
+  public:
+    DatalogReader();
+    // false once there are no more records
+    bool next(DatalogRecord &record);
+
+  private:
+    uint32_t segment;           // Next segment to open
+    File file;
+    uint8_t buf[64];
+    int len;
+    int pos;
+    uint32_t boot;
+    uint32_t start_uptime;
+    uint32_t start_time;
+    uint32_t uptime;
+    long values[DATALOG_FIELDS];
+
+    bool open_next();
+    int read_byte();
+    bool read_varint(uint32_t &value);
+};
+
+// Write out the records held in RAM
+extern void datalog_flush();
+
+extern void datalog_setup();
+extern void datalog_loop();
+
+#endif // _EMONESP_DATALOG_H
@@ -3,6 +3,7 @@
 #include "config.h"
 #include "http.h"
 #include "input.h"
+#include "publish.h"
 
 #include <Arduino.h>
 
@@ -13,34 +14,100 @@ boolean emoncms_connected = false;
 unsigned long packets_sent = 0;
 unsigned long packets_success = 0;
 
+// Values as last posted
+static PublishFilter emoncms_filter;
 
+// millis() of the last failed post, posts are not retried until
+// EMONCMS_RETRY_TIME has passed
+static unsigned long emoncms_failed_time = 0;
+static boolean emoncms_failed = false;
+
+#define EMONCMS_RETRY_TIME 30000
+
+// Each post blocks loop() until the server replies, so amp and
+// temperature changes are posted at most once per EMONCMS_MIN_INTERVAL
+// ms, readings in between go into the aggregates of the next post.
+// State and pilot changes and spikes go straight away.
+#ifndef EMONCMS_MIN_INTERVAL
+#define EMONCMS_MIN_INTERVAL 30000
+#endif
+
+// millis() of the last post, good or not
+static unsigned long emoncms_post_time = 0;
+static boolean emoncms_posted = false;
+
+const char *e_url = "/input/post.json?node=";
+
+// -------------------------------------------------------------------
+// Post the fields that have changed, or are due a heartbeat
+// -------------------------------------------------------------------
 void
-emoncms_publish(String url) {
-  if (emoncms_apikey != 0) {
-    DEBUG.println(emoncms_server.c_str() + String(url));
+emoncms_publish(const EvseTelemetry &evse) {
+  if (config_emoncms_apikey()[0]) {
+    publish_sample(emoncms_filter, evse);
+    if (emoncms_failed && (millis() - emoncms_failed_time) < EMONCMS_RETRY_TIME) {
+      return;
+    }
+    uint8_t fields = publish_due(emoncms_filter, evse);
+    if (0 == fields) {
+      return;
+    }
+    if (emoncms_posted && (millis() - emoncms_post_time) < EMONCMS_MIN_INTERVAL &&
+        0 == publish_urgent(emoncms_filter, evse)) {
+      return;
+    }
+
+    char data[192];
+    publish_format(emoncms_filter, evse, fields, data, sizeof(data));
+
+    char url[320];
+    snprintf(url, sizeof(url), "%s%s&json={%s}&%s=%s", e_url, config_emoncms_node(), data,
+             // data.openevse uses device module, emoncms.org does not
+             0 == strcmp(config_emoncms_server(), "data.openevse.com/emoncms") ?
+               "devicekey" : "apikey",
+             config_emoncms_apikey());
+
+    DEBUG.print(config_emoncms_server());
+    DEBUG.println(url);
     packets_sent++;
+    emoncms_post_time = millis();
+    emoncms_posted = true;
     // Send data to Emoncms server
     String result = "";
-    if (emoncms_fingerprint != 0) {
+    if (config_emoncms_fingerprint()[0]) {
       // HTTPS on port 443 if HTTPS fingerprint is present
       DEBUG.println("HTTPS");
       delay(10);
       result =
-        get_https(emoncms_fingerprint.c_str(), emoncms_server.c_str(), url,
+        get_https(config_emoncms_fingerprint(), config_emoncms_server(), url,
                   443);
     } else {
       // Plain HTTP if other emoncms server e.g EmonPi
       DEBUG.println("HTTP");
       delay(10);
-      result = get_http(emoncms_server.c_str(), url);
+      result = get_http(config_emoncms_server(), url);
     }
     if (result == "ok") {
       packets_success++;
       emoncms_connected = true;
+      emoncms_failed = false;
+      publish_sent(emoncms_filter, evse, fields);
     } else {
       emoncms_connected = false;
+      emoncms_failed = true;
+      emoncms_failed_time = millis();
       DEBUG.print("Emoncms error: ");
       DEBUG.println(result);
     }
   }
 }
+
+// -------------------------------------------------------------------
+// Post every field on the next call, e.g. after the settings change
+// -------------------------------------------------------------------
+void
+emoncms_restart() {
+  publish_reset(emoncms_filter);
+  emoncms_failed = false;
+  emoncms_posted = false;
+}
@@ -3,12 +3,15 @@
 
 #include <Arduino.h>
 
+#include "input.h"
+
 
 extern boolean emoncms_connected;
 extern unsigned long packets_sent;
 extern unsigned long packets_success;
 
-
-void emoncms_publish(String data);
+// Post the fields that have changed since the last post
+void emoncms_publish(const EvseTelemetry &evse);
+void emoncms_restart();
 
 #endif // _EMONESP_EMONCMS_H
@@ -0,0 +1,162 @@
+#include "emonesp.h"
+#include "events.h"
+#include "input.h"
+#include "json.h"
+#include "debug.h"
+
+#include <Arduino.h>
+
+#define EVENTS_FIELDS 8
+
+static const char *events_fields[EVENTS_FIELDS] = {
+  "amp", "pilot", "temp1", "temp2", "temp3", "estate", "wattsec", "watthour"
+};
+
+static long
+events_value(const EvseTelemetry &evse, int field) {
+  switch (field) {
+    case 0: return evse.amp;
+    case 1: return evse.pilot;
+    case 2: return evse.temp1;
+    case 3: return evse.temp2;
+    case 4: return evse.temp3;
+    case 5: return evse.state;
+    case 6: return evse.wattsec;
+    case 7: return evse.watthour_total;
+  }
+  return 0;
+}
+
+// What each client has been sent
+struct EventsClient {
+  uint32_t id;                  // 0 if the slot is free
+  bool sent;                    // values has been filled in
+  long values[EVENTS_FIELDS];
+};
+
+static AsyncWebSocket events_ws("/ws");
+static EventsClient events_clients[EVENTS_MAX_CLIENTS];
+static uint32_t events_generation = 0;     // Telemetry last looked at
+static bool events_pending = false;        // A client was skipped
+
+// Formats a frame into a fixed buffer
+class EventsFrame : public Print {
+  public:
+    EventsFrame() : len(0) {
+    }
+
+    size_t write(uint8_t c) {
+      return write(&c, 1);
+    }
+
+    size_t write(const uint8_t *data, size_t count) {
+      count = min(count, sizeof(buf) - 1 - len);
+      memcpy(buf + len, data, count);
+      len += count;
+      buf[len] = '\0';
+      return count;
+    }
+
+    char buf[192];
+    size_t len;
+};
+
+static void
+events_event(AsyncWebSocket *server, AsyncWebSocketClient *client,
+             AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  if (WS_EVT_CONNECT == type) {
+    for (int i = 0; i < EVENTS_MAX_CLIENTS; i++) {
+      if (0 == events_clients[i].id) {
+        events_clients[i].id = client->id();
+        events_clients[i].sent = false;
+        events_pending = true;
+        DBUGF("WebSocket client %u connected", client->id());
+        return;
+      }
+    }
+    DBUGF("WebSocket client %u refused, too many clients", client->id());
+    client->close();
+  } else if (WS_EVT_DISCONNECT == type) {
+    for (int i = 0; i < EVENTS_MAX_CLIENTS; i++) {
+      if (client->id() == events_clients[i].id) {
+        events_clients[i].id = 0;
+      }
+    }
+  }
+}
+
+void
+events_setup(AsyncWebServer &server) {
+  events_ws.onEvent(events_event);
+  server.addHandler(&events_ws);
+}
+
+void
+events_authentication(const char *username, const char *password) {
+  events_ws.setAuthentication(username, password);
+}
+
+// -------------------------------------------------------------------
+// Call every time around loop()
+// -------------------------------------------------------------------
+void
+events_loop() {
+  if (input_generation() == events_generation && !events_pending) {
+    return;
+  }
+
+  EvseTelemetry evse;
+  input_snapshot(evse);
+  events_generation = evse.generation;
+  events_pending = false;
+
+  for (int i = 0; i < EVENTS_MAX_CLIENTS; i++) {
+    EventsClient &slot = events_clients[i];
+    if (0 == slot.id) {
+      continue;
+    }
+
+    AsyncWebSocketClient *client = events_ws.client(slot.id);
+    if (NULL == client) {
+      slot.id = 0;
+      continue;
+    }
+
+    uint8_t changed = 0;
+    for (int f = 0; f < EVENTS_FIELDS; f++) {
+      if (!slot.sent || events_value(evse, f) != slot.values[f]) {
+        changed |= 1 << f;
+      }
+    }
+    if (0 == changed) {
+      continue;
+    }
+
+    // Still sending the last frame, try again next time round
+    if (WS_CONNECTED != client->status() || !client->canSend() ||
+        client->client()->space() < EVENTS_MIN_SPACE) {
+      events_pending = true;
+      continue;
+    }
+
+    EventsFrame frame;
+    JsonWriter json(frame);
+    json.begin_object();
+    for (int f = 0; f < EVENTS_FIELDS; f++) {
+      if (changed & (1 << f)) {
+        long value = events_value(evse, f);
+        json.key(events_fields[f]);
+        if (5 == f) {
+          json.value(input_state_name(value));
+        } else {
+          json.quoted(value);
+        }
+        slot.values[f] = value;
+      }
+    }
+    json.end_object();
+    slot.sent = true;
+
+    client->text(frame.buf, frame.len);
+  }
+}
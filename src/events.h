@@ -0,0 +1,26 @@
+#ifndef _EMONESP_EVENTS_H
+#define _EMONESP_EVENTS_H
+
+#include <ESPAsyncWebServer.h>
+
+// -------------------------------------------------------------------
+// Live telemetry over a WebSocket
+// url: /ws
+//
+// Each client is sent the /rapiupdate telemetry values when it
+// connects, then a JSON object of just the values that have changed,
+// e.g. {"amp":"16000","estate":"Charging"}, as they change.
+//
+// Each client is brought up to date from what it was last sent, and
+// only once it has taken the previous frame, so a slow client skips
+// the intermediate values rather than queueing them.
+// -------------------------------------------------------------------
+#define EVENTS_MAX_CLIENTS  4
+#define EVENTS_MIN_SPACE    256     // Free TCP send buffer before sending
+
+extern void events_setup(AsyncWebServer &server);
+// Called when the web server credentials change
+extern void events_authentication(const char *username, const char *password);
+extern void events_loop();
+
+#endif // _EMONESP_EVENTS_H
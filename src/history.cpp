@@ -0,0 +1,107 @@
+#include "emonesp.h"
+#include "history.h"
+#include "input.h"
+
+#include <Arduino.h>
+
+static const struct {
+  const char *name;
+  int scale;                    // Stored value * scale is the real value
+} history_fields[] = {
+  { "amp", 10 },                // mA, held as 10 mA to fit in 16 bits
+  { "pilot", 1 },
+  { "temp1", 1 },
+  { "temp2", 1 },
+  { "temp3", 1 },
+  { "state", 1 }
+};
+
+#define HISTORY_FIELDS (sizeof(history_fields) / sizeof(history_fields[0]))
+
+static int16_t history_data[HISTORY_FIELDS][HISTORY_SAMPLES];
+static unsigned long history_count = 0;   // Samples taken since boot
+static unsigned long history_start = 0;   // millis() of sample 0
+static bool history_started = false;
+
+int
+history_field(const char *name) {
+  for (unsigned int i = 0; i < HISTORY_FIELDS; i++) {
+    if (0 == strcmp(name, history_fields[i].name)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+unsigned long
+history_first() {
+  return history_count > HISTORY_SAMPLES ? history_count - HISTORY_SAMPLES : 0;
+}
+
+unsigned long
+history_next() {
+  return history_count;
+}
+
+unsigned long
+history_time(unsigned long sample) {
+  return history_start + sample * HISTORY_INTERVAL;
+}
+
+unsigned long
+history_sample_at(unsigned long time) {
+  long offset = (long)(time - history_start);
+  if (offset <= 0) {
+    return 0;
+  }
+  return (offset + HISTORY_INTERVAL - 1) / HISTORY_INTERVAL;
+}
+
+bool
+history_value(int field, unsigned long sample, long &value) {
+  if (field < 0 || field >= (int)HISTORY_FIELDS ||
+      sample < history_first() || sample >= history_next()) {
+    return false;
+  }
+  value = (long)history_data[field][sample % HISTORY_SAMPLES] * history_fields[field].scale;
+  return true;
+}
+
+static int16_t
+history_clamp(long value) {
+  return value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : value;
+}
+
+// -------------------------------------------------------------------
+// Take a sample every HISTORY_INTERVAL ms
+//
+// Call every time around loop(). If loop() has been held up the last
+// reading is repeated for the missed samples so sample times stay on
+// the grid.
+// -------------------------------------------------------------------
+void
+history_loop() {
+  unsigned long now = millis();
+  if (!history_started) {
+    history_start = now;
+    history_started = true;
+  }
+
+  if ((long)(now - history_time(history_count)) < 0) {
+    return;
+  }
+
+  EvseTelemetry evse;
+  input_snapshot(evse);
+  const long values[HISTORY_FIELDS] = {
+    evse.amp, evse.pilot, evse.temp1, evse.temp2, evse.temp3, evse.state
+  };
+
+  while ((long)(now - history_time(history_count)) >= 0) {
+    unsigned int slot = history_count % HISTORY_SAMPLES;
+    for (unsigned int i = 0; i < HISTORY_FIELDS; i++) {
+      history_data[i][slot] = history_clamp(values[i] / history_fields[i].scale);
+    }
+    history_count++;
+  }
+}
@@ -0,0 +1,39 @@
+#ifndef _EMONESP_HISTORY_H
+#define _EMONESP_HISTORY_H
+
+#include <Arduino.h>
+
+// -------------------------------------------------------------------
+// Telemetry history
+//
+// The last HISTORY_SAMPLES readings of each field, taken every
+// HISTORY_INTERVAL ms, in a RAM ring buffer. Each field is held in its
+// own int16 array so reading one field walks contiguous memory.
+//
+// Samples are numbered from 0 at boot. Sample n was taken at
+// history_time(n) and is held while history_first() <= n < history_next().
+// -------------------------------------------------------------------
+#ifndef HISTORY_SAMPLES
+#define HISTORY_SAMPLES     360     // 1 hour
+#endif
+#ifndef HISTORY_INTERVAL
+#define HISTORY_INTERVAL    10000   // ms
+#endif
+
+// Field index by name, -1 if there is no such field
+extern int history_field(const char *name);
+
+extern unsigned long history_first();
+extern unsigned long history_next();
+// millis() when a sample was taken
+extern unsigned long history_time(unsigned long sample);
+// First sample taken at or after time
+extern unsigned long history_sample_at(unsigned long time);
+
+// Value of a field in the same units as /rapiupdate, false if the
+// sample is not held
+extern bool history_value(int field, unsigned long sample, long &value);
+
+extern void history_loop();
+
+#endif // _EMONESP_HISTORY_H
@@ -5,6 +5,7 @@ var baseHost = window.location.hostname;
 //var baseHost = 'openevse.local';
 //var baseHost = '192.168.4.1';
 var baseEndpoint = 'http://' + baseHost;
+var wsEndpoint = 'ws://' + baseHost + '/ws';
 
 var statusupdate = false;
 var selected_network_ssid = "";
@@ -53,6 +54,8 @@ function StatusViewModel() {
     "emoncms_connected": "",
     "mqtt_connected": "",
     "ohm_hour": "",
+    "comm_sent": "0",
+    "comm_success": "0",
     "free_heap": ""
   }, baseEndpoint + '/status');
 
@@ -123,8 +126,6 @@ ConfigViewModel.prototype.constructor = ConfigViewModel;
 
 function RapiViewModel() {
   BaseViewModel.call(this, {
-    "comm_sent": "0",
-    "comm_success": "0",
     "amp": "0",
     "pilot": "0",
     "temp1": "0",
@@ -165,6 +166,13 @@ function OpenEvseViewModel() {
   var updateTimer = null;
   var updateTime = 1 * 1000;
 
+  // Live values are pushed over the WebSocket while it is connected,
+  // the rest is polled less often. Without it everything is polled.
+  var socket = null;
+  var socketTime = 10 * 1000;
+  var socketRetryTime = 5 * 1000;
+  self.live = ko.observable(false);
+
   // Upgrade URL
   self.upgradeUrl = ko.observable('about:blank');
 
@@ -177,6 +185,7 @@ function OpenEvseViewModel() {
       self.status.update(function () {
         self.rapi.update(function () {
           self.initialised(true);
+          self.connect();
           updateTimer = setTimeout(self.update, updateTime);
           self.upgradeUrl(baseEndpoint + '/update');
           self.updating(false);
@@ -199,12 +208,37 @@ function OpenEvseViewModel() {
     }
     self.status.update(function () {
       self.rapi.update(function () {
-        updateTimer = setTimeout(self.update, updateTime);
+        updateTimer = setTimeout(self.update, self.live() ? socketTime : updateTime);
         self.updating(false);
       });
     });
   };
 
+  // -----------------------------------------------------------------------
+  // Receive changes to the live values as they happen
+  // -----------------------------------------------------------------------
+  self.connect = function () {
+    if (!("WebSocket" in window)) {
+      return;
+    }
+    socket = new WebSocket(wsEndpoint);
+    socket.onopen = function () {
+      self.live(true);
+    };
+    socket.onmessage = function (msg) {
+      ko.mapping.fromJS(JSON.parse(msg.data), self.rapi);
+    };
+    socket.onclose = function () {
+      // Back to polling until it reconnects
+      if (self.live()) {
+        self.live(false);
+        self.update();
+      }
+      socket = null;
+      setTimeout(self.connect, socketRetryTime);
+    };
+  };
+
   self.wifiConnecting = ko.observable(false);
   self.status.mode.subscribe(function (newValue) {
     if(newValue === "STA+AP" || newValue === "STA") {
@@ -1,345 +1,475 @@
 #include "emonesp.h"
 #include "input.h"
 #include "config.h"
-
-const char *e_url = "/input/post.json?node=";
-
-String url = "";
-String data = "";
+#include "rapi.h"
 
 int espflash = 0;
 int espfree = 0;
 
-int commDelay = 60;
-int rapi_command = 1;
-int rapi_command_sent = 0;
-int comm_Delay = 1000;          //Delay between each command and read or write
-unsigned long comm_Timer = 0;   //Timer for Comm requests
-
-int amp = 0;                    //OpenEVSE Current Sensor
-int volt = 0;                   //Not currently in used
-int temp1 = 0;                  //Sensor DS3232 Ambient
-int temp2 = 0;                  //Sensor MCP9808 Ambient
-int temp3 = 0;                  //Sensor TMP007 Infared
-int pilot = 0;                  //OpenEVSE Pilot Setting
-long state = 0;                 //OpenEVSE State
-String estate = "Unknown";      // Common name for State
-
-//Defaults OpenEVSE Settings
-byte rgb_lcd = 1;
-byte serial_dbg = 0;
-byte auto_service = 1;
-int service = 1;
-int current_l1 = 0;
-int current_l2 = 0;
-String current_l1min = "-";
-String current_l2min = "-";
-String current_l1max = "-";
-String current_l2max = "-";
-String current_scale = "-";
-String current_offset = "-";
-//Default OpenEVSE Safety Configuration
-byte diode_ck = 1;
-byte gfci_test = 1;
-byte ground_ck = 1;
-byte stuck_relay = 1;
-byte vent_ck = 1;
-byte temp_ck = 1;
-byte auto_start = 1;
-String firmware = "-";
-String protocol = "-";
-
-//Default OpenEVSE Fault Counters
-String gfci_count = "-";
-String nognd_count = "-";
-String stuck_count = "-";
-//OpenEVSE Session options
-String kwh_limit = "0";
-String time_limit = "0";
-
-//OpenEVSE Usage Statistics
-String wattsec = "0";
-String watthour_total = "0";
-
-unsigned long comm_sent = 0;
-unsigned long comm_success = 0;
+bool rapi_poll_pending = false; //Poll command queued, waiting for the reply
+
+bool state_notify = false;      // OpenEVSE sends async state notifications
+
+static input_state_callback_t state_subscribers[INPUT_MAX_STATE_SUBSCRIBERS];
+
+// Working copy, only touched from loop()
+static EvseTelemetry evse = {
+  0,                            // generation
+  0, 0, 0, 0, 0, 0, 0, 0,       // amp ... state_changed
+  0, 0,                         // wattsec, watthour_total
+  0, 1,                         // flags, service
+  0, 0, 0, 0, 0, 0, 0, 0,       // current_l1min ... time_limit
+  0, 0, 0,                      // fault counters
+  0, 0,                         // rtc_time, rtc_millis
+  0,                            // polls_valid
+  "-", "-"                      // firmware, protocol
+};
 
+// Published copies, evse_generation & 1 is the latest
+static EvseTelemetry evse_published[2];
+static volatile uint32_t evse_generation = 0;
+static volatile uint32_t evse_settings_generation = 0;
+
+// Settings, fault counters, versions or polls answered differ, the
+// values /config shows
+static bool
+input_settings_changed(const EvseTelemetry &a, const EvseTelemetry &b) {
+  return 0 != memcmp(&a.flags, &b.flags,
+                     offsetof(EvseTelemetry, rtc_time) - offsetof(EvseTelemetry, flags)) ||
+         0 != memcmp(&a.polls_valid, &b.polls_valid,
+                     sizeof(EvseTelemetry) - offsetof(EvseTelemetry, polls_valid));
+}
+
+// -------------------------------------------------------------------
+// Publish the working copy if it has changed
+// -------------------------------------------------------------------
+static void
+input_publish() {
+  EvseTelemetry &latest = evse_published[evse_generation & 1];
+  evse.generation = latest.generation;
+  if (evse_generation > 0 && 0 == memcmp(&evse, &latest, sizeof(evse))) {
+    return;
+  }
+
+  if (0 == evse_generation || input_settings_changed(evse, latest)) {
+    evse_settings_generation++;
+  }
+
+  // Write the buffer readers are not using, then switch to it
+  uint32_t generation = evse_generation + 1;
+  evse.generation = generation;
+  evse_published[generation & 1] = evse;
+  __sync_synchronize();
+  evse_generation = generation;
+}
 
 void
-create_rapi_json() {
-  url = e_url;
-  data = "";
-  url += String(emoncms_node) + "&json={";
-  data += "amp:" + String(amp) + ",";
-  data += "temp1:" + String(temp1) + ",";
-  data += "temp2:" + String(temp2) + ",";
-  data += "temp3:" + String(temp3) + ",";
-  data += "pilot:" + String(pilot) + ",";
-  data += "state:" + String(state);
-  url += data;
-  if (emoncms_server == "data.openevse.com/emoncms") {
-    // data.openevse uses device module
-    url += "}&devicekey=" + String(emoncms_apikey);
-  } else {
-    // emoncms.org does not use device module
-    url += "}&apikey=" + String(emoncms_apikey);
+input_snapshot(EvseTelemetry &snapshot) {
+  uint32_t generation;
+  do {
+    generation = evse_generation;
+    __sync_synchronize();
+    snapshot = evse_published[generation & 1];
+    __sync_synchronize();
+    // Only torn if republished twice while copying, but any change
+    // means there is a newer copy to be had
+  } while (generation != evse_generation);
+}
+
+uint32_t
+input_generation() {
+  return evse_generation;
+}
+
+uint32_t
+input_settings_generation() {
+  return evse_settings_generation;
+}
+
+const char *
+input_state_name(long state) {
+  switch (state) {
+    case 1: return "Not_Connected";
+    case 2: return "EV_Connected";
+    case 3: return "Charging";
+    case 4: return "Vent_Required";
+    case 5: return "Diode_Check_Failed";
+    case 6: return "GFCI_Fault";
+    case 7: return "No_Earth_Ground";
+    case 8: return "Stuck_Relay";
+    case 9: return "GFCI_Self_Test_Failed";
+    case 10: return "Over_Temperature";
+    case 254: return "Sleeping";
+    case 255: return "Disabled";
+    default: return "Unknown";
   }
+}
 
-  //DEBUG.print(emoncms_server.c_str() + String(url));
+uint32_t
+input_time() {
+  if (0 == evse.rtc_time) {
+    return 0;
+  }
+  return evse.rtc_time + (millis() - evse.rtc_millis) / 1000;
 }
 
 // -------------------------------------------------------------------
-// OpenEVSE Request
+// RAPI reply parsers
 //
-// Get RAPI Values
-// Runs from arduino main loop, runs a new command in the loop
-// on each call.  Used for values that change at runtime.
+// These fill in the working copy, it is published once the reply has
+// been parsed.
 // -------------------------------------------------------------------
 
-void
-update_rapi_values() {
-  if ((millis() - comm_Timer) >= comm_Delay) {
-    if (rapi_command_sent == 0) {
-      Serial.flush();
-    }
-    if (rapi_command_sent == 0 && rapi_command == 1) {
-      espfree = ESP.getFreeHeap();
-      Serial.println("$GE*B0");
-    }
-    if (rapi_command_sent == 1 && rapi_command == 1) {
-      while (Serial.available()) {
-        String rapiString = Serial.readStringUntil('\r');
-        if (rapiString.startsWith("$OK ")) {
-          comm_success++;
-          String qrapi;
-          qrapi = rapiString.substring(rapiString.indexOf(' '));
-          pilot = qrapi.toInt();
-        }
-      }
-    }
-    if (rapi_command_sent == 0 && rapi_command == 2) {
-      Serial.println("$GS*BE");
-    }
-    if (rapi_command_sent == 1 && rapi_command == 2) {
-      while (Serial.available()) {
-        String rapiString = Serial.readStringUntil('\r');
-        if (rapiString.startsWith("$OK ")) {
-          comm_success++;
-          String qrapi = rapiString.substring(rapiString.indexOf(' '));
-          state = strtol(qrapi.c_str(), NULL, 16);
-          if (state == 1) {
-            estate = "Not_Connected";
-          }
-          if (state == 2) {
-            estate = "EV_Connected";
-          }
-          if (state == 3) {
-            estate = "Charging";
-          }
-          if (state == 4) {
-            estate = "Vent_Required";
-          }
-          if (state == 5) {
-            estate = "Diode_Check_Failed";
-          }
-          if (state == 6) {
-            estate = "GFCI_Fault";
-          }
-          if (state == 7) {
-            estate = "No_Earth_Ground";
-          }
-          if (state == 8) {
-            estate = "Stuck_Relay";
-          }
-          if (state == 9) {
-            estate = "GFCI_Self_Test_Failed";
-          }
-          if (state == 10) {
-            estate = "Over_Temperature";
-          }
-          if (state == 254) {
-            estate = "Sleeping";
-          }
-          if (state == 255) {
-            estate = "Disabled";
-          }
-        }
-      }
-    }
-    if (rapi_command_sent == 0 && rapi_command == 3) {
-      Serial.println("$GG*B2");
-    }
-    if (rapi_command_sent == 1 && rapi_command == 3) {
-      while (Serial.available()) {
-        String rapiString = Serial.readStringUntil('\r');
-        if (rapiString.startsWith("$OK")) {
-          comm_success++;
-          String qrapi;
-          qrapi = rapiString.substring(rapiString.indexOf(' '));
-          amp = qrapi.toInt();
-          String qrapi1;
-          qrapi1 = rapiString.substring(rapiString.lastIndexOf(' '));
-          volt = qrapi1.toInt();
-        }
-      }
-    }
-    if (rapi_command_sent == 0 && rapi_command == 4) {
-      Serial.println("$GP*BB");
+// -------------------------------------------------------------------
+// Update the EVSE state and tell the subscribers if it changed
+// -------------------------------------------------------------------
+static void
+set_state(long new_state) {
+  if (new_state == evse.state) {
+    return;
+  }
+
+  evse.state = new_state;
+  evse.state_changed = millis();
+  input_publish();
+
+  const char *estate = input_state_name(evse.state);
+  for (int i = 0; i < INPUT_MAX_STATE_SUBSCRIBERS; i++) {
+    if (state_subscribers[i]) {
+      state_subscribers[i](evse.state, estate);
     }
-    if (rapi_command_sent == 1 && rapi_command == 4) {
-      while (Serial.available()) {
-        String rapiString = Serial.readStringUntil('\r');
-        if (rapiString.startsWith("$OK")) {
-          comm_success++;
-          String qrapi;
-          qrapi = rapiString.substring(rapiString.indexOf(' '));
-          temp1 = qrapi.toInt();
-          String qrapi1;
-          int firstRapiCmd = rapiString.indexOf(' ');
-          qrapi1 = rapiString.substring(rapiString.indexOf(' ', firstRapiCmd + 1));
-          temp2 = qrapi1.toInt();
-          String qrapi2;
-          qrapi2 = rapiString.substring(rapiString.lastIndexOf(' '));
-          temp3 = qrapi2.toInt();
-        }
-      }
+  }
+}
+
+bool
+input_subscribe_state(input_state_callback_t callback) {
+  for (int i = 0; i < INPUT_MAX_STATE_SUBSCRIBERS; i++) {
+    if (NULL == state_subscribers[i]) {
+      state_subscribers[i] = callback;
+      return true;
     }
-    if (rapi_command_sent == 0 && rapi_command == 5) {
-      Serial.println("$GU*C0");
+  }
+  return false;
+}
+
+static void
+parseState(const RapiTokens &reply) {
+  set_state(rapi_token_hex(reply, 1, evse.state));
+}
+
+static void
+parseCurrent(const RapiTokens &reply) {
+  evse.amp = rapi_token_int(reply, 1, evse.amp);
+  evse.volt = rapi_token_int(reply, 2, evse.volt);
+}
+
+static void
+parseTemperature(const RapiTokens &reply) {
+  evse.temp1 = rapi_token_int(reply, 1, evse.temp1);
+  evse.temp2 = rapi_token_int(reply, 2, evse.temp2);
+  evse.temp3 = rapi_token_int(reply, 3, evse.temp3);
+}
+
+static void
+parseUsage(const RapiTokens &reply) {
+  evse.wattsec = rapi_token_int(reply, 1, evse.wattsec);
+  evse.watthour_total = rapi_token_int(reply, 2, evse.watthour_total);
+}
+
+static void
+parseFaultCounters(const RapiTokens &reply) {
+  evse.gfci_count = rapi_token_hex(reply, 1, evse.gfci_count);
+  evse.nognd_count = rapi_token_hex(reply, 2, evse.nognd_count);
+  evse.stuck_count = rapi_token_hex(reply, 3, evse.stuck_count);
+}
+
+static void
+parseVersion(const RapiTokens &reply) {
+  rapi_token_copy(reply, 1, evse.firmware, sizeof(evse.firmware));
+  rapi_token_copy(reply, 2, evse.protocol, sizeof(evse.protocol));
+}
+
+static void
+parseAmmeterSettings(const RapiTokens &reply) {
+  evse.current_scale = rapi_token_int(reply, 1, evse.current_scale);
+  evse.current_offset = rapi_token_int(reply, 2, evse.current_offset);
+}
+
+static void
+parseKwhLimit(const RapiTokens &reply) {
+  evse.kwh_limit = rapi_token_int(reply, 1, evse.kwh_limit);
+}
+
+static void
+parseTimeLimit(const RapiTokens &reply) {
+  evse.time_limit = rapi_token_int(reply, 1, evse.time_limit);
+}
+
+static void
+parseSettings(const RapiTokens &reply) {
+  if (reply.count < 3) {
+    return;
+  }
+  evse.pilot = rapi_token_int(reply, 1, evse.pilot);
+  evse.flags = rapi_token_hex(reply, 2, evse.flags);
+  evse.service = (evse.flags & EVSE_FLAG_SERVICE_L2) ? 2 : 1;
+}
+
+// Days from 1970-01-01 to a date in the Gregorian calendar
+static long
+days_from_civil(int year, int month, int day) {
+  year -= month <= 2;
+  long era = year / 400;
+  long yoe = year - era * 400;
+  long doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// $OK <yr> <mo> <day> <hr> <min> <sec>, years from 2000. Boards without
+// a clock answer with out of range values such as 165.
+static void
+parseTime(const RapiTokens &reply) {
+  long year = rapi_token_int(reply, 1, -1);
+  long month = rapi_token_int(reply, 2, -1);
+  long day = rapi_token_int(reply, 3, -1);
+  long hour = rapi_token_int(reply, 4, -1);
+  long minute = rapi_token_int(reply, 5, -1);
+  long second = rapi_token_int(reply, 6, -1);
+  if (year < 0 || year > 99 || month < 1 || month > 12 || day < 1 || day > 31 ||
+      hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) {
+    evse.rtc_time = 0;
+    return;
+  }
+
+  evse.rtc_time = days_from_civil(2000 + year, month, day) * 86400 +
+                  hour * 3600 + minute * 60 + second;
+  evse.rtc_millis = millis();
+}
+
+static void
+parseCurrentCapacity(const RapiTokens &reply) {
+  if (evse.service == 1) {
+    evse.current_l1min = rapi_token_int(reply, 1, evse.current_l1min);
+    evse.current_l1max = rapi_token_int(reply, 2, evse.current_l1max);
+  } else {
+    evse.current_l2min = rapi_token_int(reply, 1, evse.current_l2min);
+    evse.current_l2max = rapi_token_int(reply, 2, evse.current_l2max);
+  }
+}
+
+// -------------------------------------------------------------------
+// RAPI poll table
+//
+// Each entry is polled every min_interval ms while the EVSE is active
+// (charging, current flowing or shortly after a state change) and every
+// max_interval ms while it is idle. Values that the OpenEVSE also pushes
+// as async notifications drop to check_interval once a notification has
+// been seen. Entries with no interval are only read when
+// handleRapiRead() asks for a full refresh. Entries are polled in table
+// order when more than one is due, so $GE (service level) comes before
+// $GC (current capacity).
+// -------------------------------------------------------------------
+// Poll commands, the checksums are computed at compile time
+static constexpr auto rapi_get_version = rapi_command("$GV");
+static constexpr auto rapi_get_ammeter_settings = rapi_command("$GA");
+static constexpr auto rapi_get_kwh_limit = rapi_command("$GH");
+static constexpr auto rapi_get_time_limit = rapi_command("$G3");
+static constexpr auto rapi_get_settings = rapi_command("$GE");
+static constexpr auto rapi_get_current_capacity = rapi_command("$GC");
+static constexpr auto rapi_get_state = rapi_command("$GS");
+static constexpr auto rapi_get_current = rapi_command("$GG");
+static constexpr auto rapi_get_temperature = rapi_command("$GP");
+static constexpr auto rapi_get_usage = rapi_command("$GU");
+static constexpr auto rapi_get_fault_counters = rapi_command("$GF");
+static constexpr auto rapi_get_time = rapi_command("$GT");
+
+typedef void (*rapi_parser_t)(const RapiTokens &reply);
+
+struct RapiPoll {
+  const char *cmd;              // Command with checksum
+  unsigned long min_interval;   // ms between polls when active, 0 for on demand only
+  unsigned long max_interval;   // ms between polls when idle
+  unsigned long check_interval; // ms between polls with notifications, 0 if not notified
+  rapi_parser_t parse;          // Called with the $OK reply
+  unsigned long last;           // millis() of the last poll
+  bool refresh;                 // Read until the next $OK or $NK
+  bool valid;                   // Answered at least once
+};
+
+static RapiPoll rapi_polls[] = {
+  { rapi_get_version.str,           0,     0,      0,     parseVersion },
+  { rapi_get_ammeter_settings.str,  0,     0,      0,     parseAmmeterSettings },
+  { rapi_get_kwh_limit.str,         0,     0,      0,     parseKwhLimit },
+  { rapi_get_time_limit.str,        0,     0,      0,     parseTimeLimit },
+  { rapi_get_settings.str,          5000,  30000,  0,     parseSettings },
+  { rapi_get_current_capacity.str,  0,     0,      0,     parseCurrentCapacity },
+  { rapi_get_state.str,             1000,  5000,   30000, parseState },
+  { rapi_get_current.str,           1000,  10000,  0,     parseCurrent },
+  { rapi_get_temperature.str,       5000,  30000,  0,     parseTemperature },
+  { rapi_get_usage.str,             5000,  60000,  0,     parseUsage },
+  { rapi_get_fault_counters.str,    30000, 120000, 0,     parseFaultCounters },
+  { rapi_get_time.str,              3600000, 3600000, 0,   parseTime },
+};
+
+#define RAPI_POLL_COUNT (sizeof(rapi_polls) / sizeof(rapi_polls[0]))
+
+// Stay on the fast poll rates this long after a state change
+#define RAPI_POLL_ACTIVE_TIME 30000
+
+// Time between attempts of a refresh that has not been answered, e.g.
+// while the OpenEVSE runs its self test after a cold start
+#define RAPI_POLL_RETRY_TIME  1000
+
+// millis() when every poll had been answered, 0 until then
+unsigned long rapi_populated_time = 0;
+
+// -------------------------------------------------------------------
+// Is the EVSE doing anything that needs the fast poll rates
+// -------------------------------------------------------------------
+bool
+rapi_poll_active() {
+  if ((millis() - evse.state_changed) < RAPI_POLL_ACTIVE_TIME || evse.amp > 0) {
+    return true;
+  }
+
+  switch (evse.state) {
+    case 1:     // Not_Connected
+    case 254:   // Sleeping
+    case 255:   // Disabled
+      return false;
+  }
+  return true;
+}
+
+static unsigned long
+rapi_poll_interval(const RapiPoll &poll, bool active) {
+  if (state_notify && poll.check_interval > 0) {
+    return poll.check_interval;
+  }
+  return active ? poll.min_interval : poll.max_interval;
+}
+
+int
+rapi_poll_count() {
+  return RAPI_POLL_COUNT;
+}
+
+const char *
+rapi_poll_command(int index) {
+  return rapi_polls[index].cmd;
+}
+
+unsigned long
+rapi_poll_interval(int index) {
+  return rapi_poll_interval(rapi_polls[index], rapi_poll_active());
+}
+
+bool
+rapi_poll_valid(int index) {
+  return rapi_polls[index].valid;
+}
+
+static void
+handlePollReply(int result, const RapiTokens &reply, void *ctx) {
+  RapiPoll *poll = (RapiPoll *)ctx;
+  // A $NK counts as an answer, e.g. $GT on an OpenEVSE without a real
+  // time clock, and the value stays at its default. Only timeouts are
+  // retried.
+  if (RAPI_RESULT_TIMEOUT != result) {
+    if (RAPI_RESULT_OK == result) {
+      poll->parse(reply);
     }
-    if (rapi_command_sent == 1 && rapi_command == 5) {
-      while (Serial.available()) {
-        String rapiString = Serial.readStringUntil('\r');
-        if (rapiString.startsWith("$OK")) {
-          comm_success++;
-          int firstRapiCmd = rapiString.indexOf(' ');
-          int secondRapiCmd = rapiString.indexOf(' ', firstRapiCmd + 1);
-          wattsec = rapiString.substring(firstRapiCmd, secondRapiCmd);
-          watthour_total = rapiString.substring(secondRapiCmd);
+    poll->refresh = false;
+    if (!poll->valid) {
+      poll->valid = true;
+      evse.polls_valid |= 1UL << (poll - rapi_polls);
+      if (0 == rapi_populated_time) {
+        bool populated = true;
+        for (unsigned int i = 0; i < RAPI_POLL_COUNT && populated; i++) {
+          populated = rapi_polls[i].valid;
         }
-      }
-    }
-    if (rapi_command_sent == 0 && rapi_command == 6) {
-      Serial.println("$GF*B1");
-    }
-    if (rapi_command_sent == 1 && rapi_command == 6) {
-      while (Serial.available()) {
-        String rapiString = Serial.readStringUntil('\r');
-        if (rapiString.startsWith("$OK")) {
-          comm_success++;
-          int firstRapiCmd = rapiString.indexOf(' ');
-          int secondRapiCmd = rapiString.indexOf(' ', firstRapiCmd + 1);
-          int thirdRapiCmd = rapiString.indexOf(' ', secondRapiCmd + 1);
-          gfci_count = rapiString.substring(firstRapiCmd, secondRapiCmd);
-          nognd_count = rapiString.substring(secondRapiCmd, thirdRapiCmd);
-          stuck_count = rapiString.substring(thirdRapiCmd);
+        if (populated) {
+          rapi_populated_time = millis();
         }
       }
-      rapi_command = 0;         //Last RAPI command
     }
-    if (rapi_command_sent == 0) {
-      rapi_command_sent = 1;
-      comm_sent++;
-    } else {
-      rapi_command++;
-      rapi_command_sent = 0;
-    }
-    comm_Timer = millis();
+    input_publish();
   }
+  rapi_poll_pending = false;
 }
 
-void
-handleRapiRead() {
-  Serial.flush();
-  Serial.println("$GV*C1");
-  comm_sent++;
-  delay(commDelay);
-  while (Serial.available()) {
-    String rapiString = Serial.readStringUntil('\r');
-    if (rapiString.startsWith("$OK")) {
-      comm_success++;
-      int firstRapiCmd = rapiString.indexOf(' ');
-      int secondRapiCmd = rapiString.indexOf(' ', firstRapiCmd + 1);
-      firmware = rapiString.substring(firstRapiCmd, secondRapiCmd);
-      protocol = rapiString.substring(secondRapiCmd);
-    }
-  }
-  Serial.println("$GA*AC");
-  comm_sent++;
-  delay(commDelay);
-  while (Serial.available()) {
-    String rapiString = Serial.readStringUntil('\r');
-    if (rapiString.startsWith("$OK")) {
-      comm_success++;
-      int firstRapiCmd = rapiString.indexOf(' ');
-      int secondRapiCmd = rapiString.indexOf(' ', firstRapiCmd + 1);
-      current_scale = rapiString.substring(firstRapiCmd, secondRapiCmd);
-      current_offset = rapiString.substring(secondRapiCmd);
-    }
-  }
-  Serial.println("$GH");
-  comm_sent++;
-  delay(commDelay);
-  while (Serial.available()) {
-    String rapiString = Serial.readStringUntil('\r');
-    if (rapiString.startsWith("$OK")) {
-      comm_success++;
-      int firstRapiCmd = rapiString.indexOf(' ');
-      kwh_limit = rapiString.substring(firstRapiCmd);
-    }
+// -------------------------------------------------------------------
+// Async notifications from the OpenEVSE
+//
+// $ST <state>                                      state change
+// $AT <state> <pilot state> <current> <vflags>     state change
+// $AB <post code> <version>                        OpenEVSE booted
+// -------------------------------------------------------------------
+static void
+handleRapiNotify(const RapiTokens &notification) {
+  if (rapi_token_equals(notification, 0, "$ST") ||
+      rapi_token_equals(notification, 0, "$AT")) {
+    state_notify = true;
+    set_state(rapi_token_hex(notification, 1, evse.state));
+  } else if (rapi_token_equals(notification, 0, "$AB")) {
+    // Settings may have been lost or changed, read everything again
+    handleRapiRead();
   }
-  Serial.println("$G3");
-  comm_sent++;
-  delay(commDelay);
-  while (Serial.available()) {
-    String rapiString = Serial.readStringUntil('\r');
-    if (rapiString.startsWith("$OK")) {
-      comm_success++;
-      int firstRapiCmd = rapiString.indexOf(' ');
-      time_limit = rapiString.substring(firstRapiCmd);
-    }
+}
+
+void
+input_setup() {
+  input_publish();
+  rapi_on_notify(handleRapiNotify);
+}
+
+// -------------------------------------------------------------------
+// OpenEVSE Request
+//
+// Get RAPI Values
+// Runs from arduino main loop, queues the next poll that is due.
+// Used for values that change at runtime.
+// -------------------------------------------------------------------
+void
+update_rapi_values() {
+  // Only keep one poll in the queue so interactive commands are not
+  // held up behind a backlog of stale polls
+  if (rapi_poll_pending) {
+    return;
   }
-  Serial.println("$GE*B0");
-  comm_sent++;
-  delay(commDelay);
-  while (Serial.available()) {
-    String rapiString = Serial.readStringUntil('\r');
-    if (rapiString.startsWith("$OK ")) {
-      comm_success++;
-      String qrapi;
-      qrapi = rapiString.substring(rapiString.indexOf(' '));
-      pilot = qrapi.toInt();
-      String flag = rapiString.substring(rapiString.lastIndexOf(' '));
-      long flags = strtol(flag.c_str(), NULL, 16);
-      service = bitRead(flags, 0) + 1;
-      diode_ck = bitRead(flags, 1);
-      vent_ck = bitRead(flags, 2);
-      ground_ck = bitRead(flags, 3);
-      stuck_relay = bitRead(flags, 4);
-      auto_service = bitRead(flags, 5);
-      auto_start = bitRead(flags, 6);
-      serial_dbg = bitRead(flags, 7);
-      rgb_lcd = bitRead(flags, 8);
-      gfci_test = bitRead(flags, 9);
-      temp_ck = bitRead(flags, 10);
+
+  unsigned long now = millis();
+  bool active = rapi_poll_active();
+  for (unsigned int i = 0; i < RAPI_POLL_COUNT; i++) {
+    RapiPoll &poll = rapi_polls[i];
+    unsigned long interval = rapi_poll_interval(poll, active);
+    if (poll.refresh && (interval == 0 || interval > RAPI_POLL_RETRY_TIME)) {
+      interval = RAPI_POLL_RETRY_TIME;
     }
-  }
-  Serial.println("$GC*AE");
-  comm_sent++;
-  delay(commDelay);
-  while (Serial.available()) {
-    String rapiString = Serial.readStringUntil('\r');
-    if (rapiString.startsWith("$OK")) {
-      comm_success++;
-      int firstRapiCmd = rapiString.indexOf(' ');
-      int secondRapiCmd = rapiString.indexOf(' ', firstRapiCmd + 1);
-      if (service == 1) {
-        current_l1min = rapiString.substring(firstRapiCmd, secondRapiCmd);
-        current_l1max = rapiString.substring(secondRapiCmd);
-      } else {
-        current_l2min = rapiString.substring(firstRapiCmd, secondRapiCmd);
-        current_l2max = rapiString.substring(secondRapiCmd);
+    if ((poll.refresh || interval > 0) && (now - poll.last) >= interval) {
+      // No resends, the next poll will come round soon enough
+      if (rapi_send(poll.cmd, RAPI_PRIORITY_LOW, handlePollReply, &poll,
+                    RAPI_TIMEOUT, 0)) {
+        espfree = ESP.getFreeHeap();
+        rapi_poll_pending = true;
+        poll.last = now;
       }
+      return;
     }
   }
 }
+
+// -------------------------------------------------------------------
+// Read all RAPI values
+//
+// Marks every poll for reading, the values are filled in by the
+// parsers as the OpenEVSE answers. Reads are retried until answered,
+// a $NK leaves the value as it was.
+// -------------------------------------------------------------------
+void
+handleRapiRead() {
+  for (unsigned int i = 0; i < RAPI_POLL_COUNT; i++) {
+    rapi_polls[i].refresh = true;
+  }
+}
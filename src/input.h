@@ -3,70 +3,108 @@
 
 #include <Arduino.h>
 
-extern String url;
-extern String data;
-
 extern int espflash;
 extern int espfree;
 
-extern int commDelay;
-
-extern int amp; //OpenEVSE Current Sensor
-extern int volt; //Not currently in used
-extern int temp1; //Sensor DS3232 Ambient
-extern int temp2; //Sensor MCP9808 Ambient
-extern int temp3; //Sensor TMP007 Infared
-extern int pilot; //OpenEVSE Pilot Setting
-extern long state; //OpenEVSE State
-extern String estate; // Common name for State
-
-//Defaults OpenEVSE Settings
-extern byte rgb_lcd;
-extern byte serial_dbg;
-extern byte auto_service;
-extern int service;
-extern int current_l1;
-extern int current_l2;
-extern String current_l1min;
-extern String current_l2min;
-extern String current_l1max;
-extern String current_l2max;
-extern String current_scale;
-extern String current_offset;
-
-//Default OpenEVSE Safety Configuration
-extern byte diode_ck;
-extern byte gfci_test;
-extern byte ground_ck;
-extern byte stuck_relay;
-extern byte vent_ck;
-extern byte temp_ck;
-extern byte auto_start;
-
-extern String firmware;
-extern String protocol;
-
-//Default OpenEVSE Fault Counters
-extern String gfci_count;
-extern String nognd_count;
-extern String stuck_count;
-
-//OpenEVSE Session options
-extern String kwh_limit;
-extern String time_limit;
-
-//OpenEVSE Usage Statistics
-extern String wattsec;
-extern String watthour_total;
-
 extern String ohm_hour;
 
-extern unsigned long comm_sent;
-extern unsigned long comm_success;
-
+// -------------------------------------------------------------------
+// OpenEVSE telemetry
+//
+// Everything read from the OpenEVSE, held as native values. loop()
+// fills in a working copy as RAPI replies arrive and publishes it into
+// one of two buffers; input_snapshot() copies the latest published
+// buffer, retrying if it was republished part way through, so readers
+// in any context get a consistent set of values without locking.
+// -------------------------------------------------------------------
+struct EvseTelemetry {
+  uint32_t generation;          // Bumped each time a change is published
+
+  // Live values
+  int32_t amp;                  // mA, OpenEVSE current sensor
+  int32_t volt;                 // mV, not currently in use
+  int16_t temp1;                // 0.1 C, sensor DS3232 ambient
+  int16_t temp2;                // 0.1 C, sensor MCP9808 ambient
+  int16_t temp3;                // 0.1 C, sensor TMP007 infrared
+  uint8_t pilot;                // A, pilot setting
+  uint8_t state;                // OpenEVSE state, see input_state_name()
+  uint32_t state_changed;       // millis() of the last state change
+
+  // Usage statistics
+  uint32_t wattsec;             // This session
+  uint32_t watthour_total;
+
+  // Settings
+  uint16_t flags;               // $GE flags, see EVSE_FLAG_*
+  uint8_t service;              // Service level, 1 or 2
+  uint8_t current_l1min;
+  uint8_t current_l1max;
+  uint8_t current_l2min;
+  uint8_t current_l2max;
+  int16_t current_scale;
+  int16_t current_offset;
+  uint16_t kwh_limit;
+  uint16_t time_limit;
+
+  // Fault counters
+  uint32_t gfci_count;
+  uint32_t nognd_count;
+  uint32_t stuck_count;
+
+  // OpenEVSE real time clock
+  uint32_t rtc_time;            // Unix time, 0 if there is no clock
+  uint32_t rtc_millis;          // millis() when rtc_time was read
+
+  uint32_t polls_valid;         // Bit per RAPI poll, answered at least once
+
+  char firmware[12];
+  char protocol[8];
+};
+
+// $GE flags, as ECF_* in the OpenEVSE firmware. The check, auto service
+// and auto start bits are set when that feature is disabled.
+#define EVSE_FLAG_SERVICE_L2      0x0001
+#define EVSE_FLAG_DIODE_CK        0x0002
+#define EVSE_FLAG_VENT_CK         0x0004
+#define EVSE_FLAG_GROUND_CK       0x0008
+#define EVSE_FLAG_STUCK_RELAY     0x0010
+#define EVSE_FLAG_AUTO_SERVICE    0x0020
+#define EVSE_FLAG_AUTO_START      0x0040
+#define EVSE_FLAG_SERIAL_DBG      0x0080
+#define EVSE_FLAG_MONO_LCD        0x0100
+#define EVSE_FLAG_GFCI_TEST       0x0200
+#define EVSE_FLAG_TEMP_CK         0x0400
+
+extern void input_snapshot(EvseTelemetry &snapshot);
+// Generation of the latest snapshot, changes whenever a value does
+extern uint32_t input_generation();
+// Changes only with the settings, fault counters, firmware versions
+// and polls answered, not the live values
+extern uint32_t input_settings_generation();
+extern const char *input_state_name(long state);
+// Unix time from the OpenEVSE clock, 0 if it has none or it is unread
+extern uint32_t input_time();
+
+// State change subscribers, called from loop() as soon as a change is
+// seen, either from an async notification or from polling $GS
+#define INPUT_MAX_STATE_SUBSCRIBERS 4
+typedef void (*input_state_callback_t)(long state, const char *estate);
+extern bool input_subscribe_state(input_state_callback_t callback);
+
+// Effective RAPI poll rates
+extern bool rapi_poll_active();
+extern int rapi_poll_count();
+extern const char *rapi_poll_command(int index);
+extern unsigned long rapi_poll_interval(int index);
+// Poll has been answered at least once, with $OK or $NK if the
+// OpenEVSE does not support it
+extern bool rapi_poll_valid(int index);
+// millis() when every poll had been answered, 0 until then
+extern unsigned long rapi_populated_time;
+
+extern void input_setup();
 extern void handleRapiRead();
 extern void update_rapi_values();
-extern void create_rapi_json();
 
 
 #endif // _EMONESP_INPUT_H
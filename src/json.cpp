@@ -0,0 +1,198 @@
+#include "emonesp.h"
+#include "json.h"
+
+#include <Arduino.h>
+
+static void
+json_skip_space(JsonReader &reader) {
+  while (reader.pos < reader.end &&
+         (' ' == *reader.pos || '\t' == *reader.pos ||
+          '\r' == *reader.pos || '\n' == *reader.pos)) {
+    reader.pos++;
+  }
+}
+
+void
+json_reader_init(JsonReader &reader, const char *json, size_t len) {
+  reader.pos = json;
+  reader.end = json + len;
+}
+
+bool
+json_expect(JsonReader &reader, char c) {
+  json_skip_space(reader);
+  if (reader.pos < reader.end && c == *reader.pos) {
+    reader.pos++;
+    return true;
+  }
+  return false;
+}
+
+int
+json_read_string(JsonReader &reader, char *buf, int size) {
+  if (!json_expect(reader, '"')) {
+    return -1;
+  }
+
+  int len = 0;
+  while (reader.pos < reader.end) {
+    char c = *reader.pos++;
+    if ('"' == c) {
+      buf[len] = '\0';
+      return len;
+    }
+    if ('\\' == c) {
+      if (reader.pos >= reader.end) {
+        return -1;
+      }
+      c = *reader.pos++;
+      switch (c) {
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u': {
+          // Only ASCII is expected, anything else becomes '?'
+          if (reader.end - reader.pos < 4) {
+            return -1;
+          }
+          char hex[5] = { reader.pos[0], reader.pos[1], reader.pos[2], reader.pos[3], '\0' };
+          char *hex_end;
+          long code = strtol(hex, &hex_end, 16);
+          if (hex_end != hex + 4) {
+            return -1;
+          }
+          c = code < 0x80 ? (char)code : '?';
+          reader.pos += 4;
+          break;
+        }
+      }
+    }
+    if (len >= size - 1) {
+      return -1;
+    }
+    buf[len++] = c;
+  }
+
+  return -1;
+}
+
+bool
+json_at_end(JsonReader &reader) {
+  json_skip_space(reader);
+  return reader.pos == reader.end;
+}
+
+void
+json_print_string(Print &out, const char *str) {
+  out.print('"');
+  while (*str) {
+    // Write runs of plain characters in one go
+    const char *run = str;
+    while (*str && *str != '"' && *str != '\\' && (unsigned char)*str >= 0x20) {
+      str++;
+    }
+    if (str > run) {
+      out.write((const uint8_t *)run, str - run);
+    }
+    if (0 == *str) {
+      break;
+    }
+
+    char c = *str++;
+    switch (c) {
+      case '"': out.print("\\\""); break;
+      case '\\': out.print("\\\\"); break;
+      case '\n': out.print("\\n"); break;
+      case '\r': out.print("\\r"); break;
+      case '\t': out.print("\\t"); break;
+      default: out.printf("\\u%04x", c); break;
+    }
+  }
+  out.print('"');
+}
+
+// -------------------------------------------------------------------
+// Streaming writer
+// -------------------------------------------------------------------
+void
+JsonWriter::separator() {
+  if (after_key) {
+    after_key = false;
+    return;
+  }
+  if (first & (1UL << depth)) {
+    first &= ~(1UL << depth);
+  } else {
+    out.print(',');
+  }
+}
+
+void
+JsonWriter::open(char c) {
+  separator();
+  out.print(c);
+  depth++;
+  first |= 1UL << depth;
+}
+
+void
+JsonWriter::close(char c) {
+  depth--;
+  out.print(c);
+}
+
+void
+JsonWriter::key(const char *name) {
+  separator();
+  json_print_string(out, name);
+  out.print(':');
+  after_key = true;
+}
+
+void
+JsonWriter::value(const char *str) {
+  separator();
+  json_print_string(out, str);
+}
+
+void
+JsonWriter::value(bool b) {
+  separator();
+  out.print(b ? "true" : "false");
+}
+
+void
+JsonWriter::value(long n) {
+  separator();
+  out.print(n);
+}
+
+void
+JsonWriter::value(unsigned long n) {
+  separator();
+  out.print(n);
+}
+
+void
+JsonWriter::null() {
+  separator();
+  out.print("null");
+}
+
+void
+JsonWriter::quoted(long n) {
+  separator();
+  out.print('"');
+  out.print(n);
+  out.print('"');
+}
+
+void
+JsonWriter::quoted_hex(unsigned long n) {
+  char hex[12];
+  snprintf(hex, sizeof(hex), "\"%lx\"", n);
+  separator();
+  out.print(hex);
+}
@@ -0,0 +1,95 @@
+#ifndef _EMONESP_JSON_H
+#define _EMONESP_JSON_H
+
+#include <Arduino.h>
+
+// -------------------------------------------------------------------
+// Minimal JSON support
+//
+// A pull reader over a buffer that never allocates. Strings are
+// unescaped into caller supplied buffers.
+// -------------------------------------------------------------------
+struct JsonReader {
+  const char *pos;
+  const char *end;
+};
+
+extern void json_reader_init(JsonReader &reader, const char *json, size_t len);
+
+// Skip whitespace and consume c if it is next
+extern bool json_expect(JsonReader &reader, char c);
+
+// Read a quoted string, returns its length or -1 if it is not a valid
+// string or does not fit in size
+extern int json_read_string(JsonReader &reader, char *buf, int size);
+
+// Nothing but whitespace left
+extern bool json_at_end(JsonReader &reader);
+
+// Write str as a quoted JSON string
+extern void json_print_string(Print &out, const char *str);
+
+// -------------------------------------------------------------------
+// Streaming writer
+//
+// Writes JSON straight to out, e.g. an AsyncResponseStream, adding the
+// commas between members and escaping strings, so a reply is never
+// built up in a String first.
+//
+//   JsonWriter json(*response);
+//   json.begin_object();
+//   json.member("ssid", esid);
+//   json.member("amp", evse.amp);
+//   json.end_object();
+// -------------------------------------------------------------------
+class JsonWriter {
+  public:
+    JsonWriter(Print &out) : out(out), depth(0), first(1), after_key(false) {
+    }
+
+    void begin_object() { open('{'); }
+    void end_object() { close('}'); }
+    void begin_array() { open('['); }
+    void end_array() { close(']'); }
+
+    // Name of the next object member
+    void key(const char *name);
+
+    void value(const char *str);
+    void value(const String &str) { value(str.c_str()); }
+    void value(bool b);
+    void value(int n) { value((long)n); }
+    void value(unsigned int n) { value((unsigned long)n); }
+    void value(long n);
+    void value(unsigned long n);
+    void null();
+    // Numbers as strings, as much of the HTTP API has them
+    void quoted(long n);
+    void quoted_hex(unsigned long n);
+
+    template <typename T>
+    void member(const char *name, T v) {
+      key(name);
+      value(v);
+    }
+    void member_quoted(const char *name, long n) {
+      key(name);
+      quoted(n);
+    }
+    void member_quoted_hex(const char *name, unsigned long n) {
+      key(name);
+      quoted_hex(n);
+    }
+
+  private:
+    Print &out;
+    uint8_t depth;
+    uint32_t first;             // Bit per depth, nothing written at that depth yet
+    bool after_key;
+
+    void separator();
+    void open(char c);
+    void close(char c);
+};
+
+#endif // _EMONESP_JSON_H
@@ -1,6 +1,9 @@
 #include "emonesp.h"
 #include "mqtt.h"
 #include "config.h"
+#include "rapi.h"
+#include "session.h"
+#include "publish.h"
 
 #include <Arduino.h>
 #include <PubSubClient.h>       // MQTT https://github.com/knolleary/pubsubclient PlatformIO lib: 89
@@ -15,6 +18,38 @@ long lastMqttReconnectAttempt = 0;
 int clientTimeout = 0;
 int i = 0;
 
+// Completed sessions up to this id have been published, sessions from
+// before boot are not
+uint32_t mqtt_session_published = 0;
+bool mqtt_session_started = false;
+
+// Values as last published, everything is published again on reconnect
+PublishFilter mqtt_filter;
+unsigned long mqtt_freeram_time = 0;
+bool mqtt_freeram_sent = false;
+
+// Room for the base topic and the longest sub-topic
+#define MQTT_TOPIC_SIZE (sizeof(config.mqtt_topic) + 16)
+
+// <base-topic>/<name>
+static const char *
+mqtt_topic_name(char *topic, const char *name) {
+  snprintf(topic, MQTT_TOPIC_SIZE, "%s/%s", config_mqtt_topic(), name);
+  return topic;
+}
+
+
+// -------------------------------------------------------------------
+// RAPI reply to a command received via MQTT
+// Publish the $OK/$NK responce under the "rapi/out" topic
+// -------------------------------------------------------------------
+void
+mqtt_rapi_reply(int result, const RapiTokens &reply, void *) {
+  if (RAPI_RESULT_TIMEOUT != result) {
+    char topic[MQTT_TOPIC_SIZE];
+    mqttclient.publish(mqtt_topic_name(topic, "rapi/out"), reply.line);
+  }
+}
 
 // -------------------------------------------------------------------
 // MQTT msg Received callback function:
@@ -40,31 +75,22 @@ mqttmsg_callback(char *topic, byte * payload, unsigned int length) {
 
   // Detect if MQTT message is a RAPI command e.g to set 13A <base-topic>/rapi/$SC 13
   if (rapi_character_index > 1) {
-    // Print RAPI command from mqtt-sub topic e.g $SC
-    // ASSUME RAPI COMMANDS ARE ALWAYS PREFIX BY $ AND TWO CHARACTERS LONG)
-    Serial.flush();
-    for (int i = rapi_character_index; i < rapi_character_index + 3; i++) {
-      Serial.print(topic[i]);
-    }
-    if (payload[0] != 0); {     // If MQTT msg contains a payload e.g $SC 13. Not all rapi commands have a payload e.g. $GC
-      Serial.print(" ");        // print space to seperate RAPI commnd from value
-      // print RAPI value received via MQTT serial
-      for (int i = 0; i < length; i++) {
-        Serial.print((char) payload[i]);
-      }
-    }
-    Serial.println();           // End of RAPI command serial print (new line)
-
-    // Check RAPI command has been succesful by listing for $OK responce and publish to MQTT under "rapi/out" topic
-    delay(60);                  // commDelay = 60 (input.cpp)
-    while (Serial.available()) {
-      String rapiString = Serial.readStringUntil('\r');
-      if (rapiString.startsWith("$OK ") || rapiString.startsWith("$NK ")) {
-        String mqtt_data = rapiString;
-        String mqtt_sub_topic = mqtt_topic + "/rapi/out";
-        mqttclient.publish(mqtt_sub_topic.c_str(), mqtt_data.c_str());
+    // RAPI command from mqtt-sub topic e.g $SC
+    char cmd[RAPI_MAX_COMMAND];
+    int len = snprintf(cmd, sizeof(cmd), "%s", topic + rapi_character_index);
+    // If MQTT msg contains a payload e.g $SC 13. Not all rapi commands have a payload e.g. $GC
+    if (length > 0) {
+      if (len + 1 + length >= sizeof(cmd)) {
+        DEBUG.println("RAPI command too long");
+        return;
       }
+      cmd[len++] = ' ';         // space to seperate RAPI commnd from value
+      memcpy(cmd + len, payload, length);
+      cmd[len + length] = '\0';
     }
+
+    // The reply is published to MQTT by mqtt_rapi_reply() once received
+    rapi_send(cmd, RAPI_PRIORITY_HIGH, mqtt_rapi_reply);
   }
 
 
@@ -75,17 +101,20 @@ mqttmsg_callback(char *topic, byte * payload, unsigned int length) {
 // -------------------------------------------------------------------
 boolean
 mqtt_connect() {
-  mqttclient.setServer(mqtt_server.c_str(), 1883);
+  mqttclient.setServer(config_mqtt_server(), 1883);
   mqttclient.setCallback(mqttmsg_callback);     //function to be called when mqtt msg is received on subscribed topic
   DEBUG.print("MQTT Connecting to...");
-  DEBUG.println(mqtt_user.c_str());
+  DEBUG.println(config_mqtt_user());
   String strID = String(ESP.getChipId());
-  if (mqttclient.connect(strID.c_str(), mqtt_user.c_str(), mqtt_pass.c_str())) {        // Attempt to connect
+  if (mqttclient.connect(strID.c_str(), config_mqtt_user(), config_mqtt_pass())) {        // Attempt to connect
     DEBUG.println("MQTT connected");
-    mqttclient.publish(mqtt_topic.c_str(), "connected");        // Once connected, publish an announcement..
-    String mqtt_sub_topic = mqtt_topic + "/rapi/in/#";  // MQTT Topic to subscribe to receive RAPI commands via MQTT
+    mqttclient.publish(config_mqtt_topic(), "connected");        // Once connected, publish an announcement..
+    char topic[MQTT_TOPIC_SIZE];
+    // MQTT Topic to subscribe to receive RAPI commands via MQTT
     //e.g to set current to 13A: <base-topic>/rapi/in/$SC 13
-    mqttclient.subscribe(mqtt_sub_topic.c_str());
+    mqttclient.subscribe(mqtt_topic_name(topic, "rapi/in/#"));
+    publish_reset(mqtt_filter);
+    mqtt_freeram_sent = false;
   } else {
     DEBUG.print("MQTT failed: ");
     DEBUG.println(mqttclient.state());
@@ -97,46 +126,82 @@ mqtt_connect() {
 
 
 // -------------------------------------------------------------------
-// Publish status to MQTT
+// Publish the fields that have changed, or are due a heartbeat, each
+// to its own sub-topic e.g. <base-topic>/amp
 // -------------------------------------------------------------------
 void
-mqtt_publish(String data) {
-  String mqtt_data = "";
-  String topic = mqtt_topic + "/";
-
-  int i = 0;
-  while (int (data[i]) != 0) {
-    // Construct MQTT topic e.g. <base_topic>/<status> data
-    while (data[i] != ':') {
-      topic += data[i];
-      i++;
-      if (int (data[i]) == 0) {
+mqtt_publish(const EvseTelemetry &evse) {
+  publish_sample(mqtt_filter, evse);
+  if (!mqttclient.connected()) {
+    return;
+  }
+
+  uint8_t fields = publish_due(mqtt_filter, evse);
+  for (int i = 0; i < PUBLISH_FIELDS; i++) {
+    if (0 == (fields & (1 << i))) {
+      continue;
+    }
+
+    // "name:value" followed by any aggregates e.g. ",amp_max:value"
+    char data[96];
+    publish_format(mqtt_filter, evse, 1 << i, data, sizeof(data));
+    char *pair = data;
+    while (pair) {
+      char *next = strchr(pair, ',');
+      if (next) {
+        *next++ = '\0';
+      }
+      char *value = strchr(pair, ':');
+      *value++ = '\0';
+
+      char topic[MQTT_TOPIC_SIZE];
+      mqtt_topic_name(topic, pair);
+      DEBUG.printf("%s = %s\r\n", topic, value);
+      if (!mqttclient.publish(topic, value)) {
+        fields &= ~(1 << i);
         break;
       }
+      pair = next;
     }
-    i++;
-    // Construct data string to publish to above topic
-    while (data[i] != ',') {
-      mqtt_data += data[i];
-      i++;
-      if (int (data[i]) == 0) {
+  }
+  publish_sent(mqtt_filter, evse, fields);
+
+  if ((millis() - mqtt_freeram_time) >= PUBLISH_HEARTBEAT || !mqtt_freeram_sent) {
+    char topic[MQTT_TOPIC_SIZE];
+    char free_ram[12];
+    snprintf(free_ram, sizeof(free_ram), "%u", (unsigned int)ESP.getFreeHeap());
+    mqttclient.publish(mqtt_topic_name(topic, "freeram"), free_ram);
+    mqtt_freeram_time = millis();
+    mqtt_freeram_sent = true;
+  }
+}
+
+// -------------------------------------------------------------------
+// Publish a summary of each completed charging session, as JSON, once
+// the broker can be reached
+// -------------------------------------------------------------------
+void
+mqtt_publish_sessions() {
+  if (!mqtt_session_started) {
+    mqtt_session_published = session_last_id();
+    mqtt_session_started = true;
+  }
+
+  while (mqttclient.connected() && mqtt_session_published < session_last_id()) {
+    SessionRecord record;
+    // A session no longer in the journal is skipped
+    if (session_read(mqtt_session_published + 1, record)) {
+      char payload[256];
+      session_format(record, false, payload, sizeof(payload));
+      char topic[MQTT_TOPIC_SIZE];
+      if (!mqttclient.publish(mqtt_topic_name(topic, "session"), payload)) {
+        // Try the same session again next time around loop()
+        DEBUG.println("MQTT session publish failed");
         break;
       }
     }
-    // send data via mqtt
-    //delay(100);
-    DEBUG.printf("%s = %s\r\n", topic.c_str(), mqtt_data.c_str());
-    mqttclient.publish(topic.c_str(), mqtt_data.c_str());
-    topic = mqtt_topic + "/";
-    mqtt_data = "";
-    i++;
-    if (int (data[i]) == 0)
-      break;
+    mqtt_session_published++;
   }
-
-  String ram_topic = topic + "freeram";
-  String free_ram = String(ESP.getFreeHeap());
-  mqttclient.publish(ram_topic.c_str(), free_ram.c_str());
 }
 
 // -------------------------------------------------------------------
@@ -159,6 +224,8 @@ mqtt_loop() {
     // if MQTT connected
     mqttclient.loop();
   }
+
+  mqtt_publish_sessions();
 }
 
 void
@@ -3,9 +3,13 @@
 
 #include <Arduino.h>
 
+#include "input.h"
+
 extern void mqtt_msg_callback();
 extern void mqtt_loop();
-extern void mqtt_publish(String data);
+// Publish the fields that have changed since they were last published
+extern void mqtt_publish(const EvseTelemetry &evse);
+extern void mqtt_publish_sessions();
 extern void mqtt_restart();
 extern boolean mqtt_connected();
 
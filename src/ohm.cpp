@@ -2,6 +2,7 @@
 #include "input.h"
 #include "wifi.h"
 #include "config.h"
+#include "rapi.h"
 
 #include <WiFiClientSecure.h>
 #include <ESP8266HTTPClient.h>
@@ -17,6 +18,9 @@ const char *ohm_fingerprint =
 String ohm_hour = "NotConnected";
 int evse_sleep = 0;
 
+static constexpr auto rapi_enable = rapi_command("$FE");
+static constexpr auto rapi_sleep = rapi_command("$FS");
+
 
 // -------------------------------------------------------------------
 // Ohm Connect "Ohm Hour"
@@ -28,14 +32,14 @@ int evse_sleep = 0;
 void
 ohm_loop() {
 
-  if (ohm != 0) {
+  if (config_ohm_key()[0]) {
     WiFiClientSecure client;
     if (!client.connect(ohm_host, ohm_httpsPort)) {
       DEBUG.println("ERROR Ohm Connect - connection failed");
       return;
     }
     if (client.verify(ohm_fingerprint, ohm_host)) {
-      client.print(String("GET ") + ohm_url + ohm + " HTTP/1.1\r\n" +
+      client.print(String("GET ") + ohm_url + config_ohm_key() + " HTTP/1.1\r\n" +
                    "Host: " + ohm_host + "\r\n" +
                    "User-Agent: OpenEVSE\r\n" + "Connection: close\r\n\r\n");
       String line = client.readString();
@@ -44,7 +48,8 @@ ohm_loop() {
         ohm_hour = "False";
         if (evse_sleep == 1) {
           evse_sleep = 0;
-          Serial.println("$FE*AF");
+          // Safe to resend, enabling twice does no harm
+          rapi_send(rapi_enable.str, RAPI_PRIORITY_HIGH, NULL, NULL, RAPI_TIMEOUT, RAPI_RETRIES);
         }
       }
       if (line.indexOf("True") > 0) {
@@ -52,7 +57,7 @@ ohm_loop() {
         ohm_hour = "True";
         if (evse_sleep == 0) {
           evse_sleep = 1;
-          Serial.println("$FS*BD");
+          rapi_send(rapi_sleep.str, RAPI_PRIORITY_HIGH, NULL, NULL, RAPI_TIMEOUT, RAPI_RETRIES);
         }
       }
       DEBUG.println(line);
@@ -0,0 +1,207 @@
+#include "emonesp.h"
+#include "publish.h"
+#include "input.h"
+
+#include <Arduino.h>
+
+// Aggregates sent with a field
+#define PUBLISH_MIN   0x01
+#define PUBLISH_MAX   0x02
+#define PUBLISH_AVG   0x04
+
+static const struct {
+  const char *name;
+  long deadband;                // Absolute
+  long deadband_rel;            // 1/1000ths of the last value sent
+  uint8_t aggregates;           // PUBLISH_MIN etc.
+} publish_fields[PUBLISH_FIELDS] = {
+  { "amp", PUBLISH_AMP_DEADBAND, PUBLISH_AMP_DEADBAND_REL,
+    PUBLISH_MIN | PUBLISH_MAX | PUBLISH_AVG },
+  { "temp1", PUBLISH_TEMP_DEADBAND, PUBLISH_TEMP_DEADBAND_REL, PUBLISH_MAX },
+  { "temp2", PUBLISH_TEMP_DEADBAND, PUBLISH_TEMP_DEADBAND_REL, PUBLISH_MAX },
+  { "temp3", PUBLISH_TEMP_DEADBAND, PUBLISH_TEMP_DEADBAND_REL, PUBLISH_MAX },
+  { "pilot", 0, 0, 0 },         // Any change
+  { "state", 0, 0, 0 }
+};
+
+static long
+publish_value(const EvseTelemetry &evse, int field) {
+  switch (field) {
+    case 0: return evse.amp;
+    case 1: return evse.temp1;
+    case 2: return evse.temp2;
+    case 3: return evse.temp3;
+    case 4: return evse.pilot;
+    case 5: return evse.state;
+  }
+  return 0;
+}
+
+// Start the stats of a field again from its latest reading
+static void
+publish_stats_start(PublishFilter &filter, int field) {
+  PublishStats &stats = filter.stats[field];
+  stats.min = stats.max = filter.held[field];
+  stats.sum = 0;
+  stats.time = 0;
+  stats.count = 1;
+}
+
+static long
+publish_stats_avg(const PublishFilter &filter, int field) {
+  const PublishStats &stats = filter.stats[field];
+  if (0 == stats.time) {
+    return filter.held[field];
+  }
+  return stats.sum / (int64_t)stats.time;
+}
+
+void
+publish_sample(PublishFilter &filter, const EvseTelemetry &evse) {
+  unsigned long now = millis();
+  bool reading = evse.generation != filter.sample_generation;
+  uint32_t dt = now - filter.sample_time;
+
+  for (int i = 0; i < PUBLISH_FIELDS; i++) {
+    PublishStats &stats = filter.stats[i];
+    if (0 == stats.count) {
+      filter.held[i] = publish_value(evse, i);
+      publish_stats_start(filter, i);
+      continue;
+    }
+
+    // The reading held until now counts for the time it was held
+    stats.sum += (int64_t)filter.held[i] * dt;
+    stats.time += dt;
+    if (reading) {
+      long value = publish_value(evse, i);
+      filter.held[i] = value;
+      stats.min = min(stats.min, value);
+      stats.max = max(stats.max, value);
+      stats.count++;
+    }
+  }
+
+  filter.sample_time = now;
+  filter.sample_generation = evse.generation;
+}
+
+static long
+publish_deadband(const PublishFilter &filter, int field) {
+  return max(publish_fields[field].deadband,
+             labs(filter.value[field]) * publish_fields[field].deadband_rel / 1000);
+}
+
+uint8_t
+publish_due(const PublishFilter &filter, const EvseTelemetry &evse) {
+  unsigned long now = millis();
+  uint8_t due = 0;
+  bool heartbeat = false;
+
+  for (int i = 0; i < PUBLISH_FIELDS; i++) {
+    if (0 == (filter.sent & (1 << i))) {
+      due |= 1 << i;
+      continue;
+    }
+
+    // Furthest any reading since the last send has been from it
+    long last = filter.value[i];
+    long change = labs(publish_value(evse, i) - last);
+    if (filter.stats[i].count > 0) {
+      change = max(change, labs(filter.stats[i].min - last));
+      change = max(change, labs(filter.stats[i].max - last));
+    }
+    if (change > publish_deadband(filter, i)) {
+      due |= 1 << i;
+    } else if ((now - filter.time[i]) >= PUBLISH_HEARTBEAT) {
+      due |= 1 << i;
+      heartbeat = true;
+    }
+  }
+
+  if (heartbeat) {
+    // Fields that would be due within half a heartbeat go now, so the
+    // heartbeats of all the fields settle into one post
+    for (int i = 0; i < PUBLISH_FIELDS; i++) {
+      if ((now - filter.time[i]) >= PUBLISH_HEARTBEAT / 2) {
+        due |= 1 << i;
+      }
+    }
+  }
+  return due;
+}
+
+uint8_t
+publish_urgent(const PublishFilter &filter, const EvseTelemetry &evse) {
+  uint8_t urgent = 0;
+  for (int i = 0; i < PUBLISH_FIELDS; i++) {
+    if (0 == (filter.sent & (1 << i))) {
+      continue;
+    }
+
+    long last = filter.value[i];
+    long deadband = publish_deadband(filter, i);
+    if (0 == publish_fields[i].deadband && 0 == publish_fields[i].deadband_rel) {
+      if (publish_value(evse, i) != last) {
+        urgent |= 1 << i;
+      }
+    } else if (filter.stats[i].count > 0 &&
+               labs(publish_value(evse, i) - last) <= deadband &&
+               (labs(filter.stats[i].min - last) > deadband ||
+                labs(filter.stats[i].max - last) > deadband)) {
+      // A spike, already back inside the deadband
+      urgent |= 1 << i;
+    }
+  }
+  return urgent;
+}
+
+int
+publish_format(const PublishFilter &filter, const EvseTelemetry &evse,
+               uint8_t fields, char *buf, int size) {
+  int len = 0;
+  buf[0] = '\0';
+  for (int i = 0; i < PUBLISH_FIELDS && len < size; i++) {
+    if (0 == (fields & (1 << i))) {
+      continue;
+    }
+
+    const char *name = publish_fields[i].name;
+    len += snprintf(buf + len, size - len, "%s%s:%ld", len > 0 ? "," : "",
+                    name, publish_value(evse, i));
+#if PUBLISH_AGGREGATE
+    // Only once there is something to aggregate
+    uint8_t aggregates = filter.stats[i].count > 0 ? publish_fields[i].aggregates : 0;
+    if ((aggregates & PUBLISH_MIN) && len < size) {
+      len += snprintf(buf + len, size - len, ",%s_min:%ld", name, filter.stats[i].min);
+    }
+    if ((aggregates & PUBLISH_MAX) && len < size) {
+      len += snprintf(buf + len, size - len, ",%s_max:%ld", name, filter.stats[i].max);
+    }
+    if ((aggregates & PUBLISH_AVG) && len < size) {
+      len += snprintf(buf + len, size - len, ",%s_avg:%ld", name, publish_stats_avg(filter, i));
+    }
+#endif
+  }
+  return min(len, size - 1);
+}
+
+void
+publish_sent(PublishFilter &filter, const EvseTelemetry &evse, uint8_t fields) {
+  unsigned long now = millis();
+  for (int i = 0; i < PUBLISH_FIELDS; i++) {
+    if (fields & (1 << i)) {
+      filter.value[i] = publish_value(evse, i);
+      filter.time[i] = now;
+      if (filter.stats[i].count > 0) {
+        publish_stats_start(filter, i);
+      }
+    }
+  }
+  filter.sent |= fields;
+}
+
+void
+publish_reset(PublishFilter &filter) {
+  filter.sent = 0;
+}
@@ -0,0 +1,93 @@
+#ifndef _EMONESP_PUBLISH_H
+#define _EMONESP_PUBLISH_H
+
+#include <Arduino.h>
+
+#include "input.h"
+
+// -------------------------------------------------------------------
+// Change driven publishing
+//
+// Emoncms and MQTT each keep a PublishFilter holding the value of each
+// field as they last sent it. A field is due once it has moved further
+// than its deadband from that value, or has not been sent for
+// PUBLISH_HEARTBEAT ms, so only changes go out and they go out as soon
+// as the OpenEVSE is polled.
+//
+// A change must be larger than both the absolute deadband, in the
+// field's own units, and the relative deadband, in 1/1000ths of the
+// value last sent. Either can be overridden from build_flags.
+//
+// Between sends each field keeps a running min, max, time weighted
+// mean and count of the readings seen, so a spike is not lost if it
+// has gone again before the next send. A reading outside the deadband
+// makes the field due even if the latest value is back inside it.
+// With PUBLISH_AGGREGATE set, amp_min, amp_max, amp_avg and temp1_max
+// etc. are sent alongside their field.
+// -------------------------------------------------------------------
+#define PUBLISH_FIELDS              6
+
+#ifndef PUBLISH_AGGREGATE
+#define PUBLISH_AGGREGATE           1
+#endif
+#ifndef PUBLISH_HEARTBEAT
+#define PUBLISH_HEARTBEAT           300000  // ms, longest a field goes unsent
+#endif
+#ifndef PUBLISH_AMP_DEADBAND
+#define PUBLISH_AMP_DEADBAND        250     // mA
+#endif
+#ifndef PUBLISH_AMP_DEADBAND_REL
+#define PUBLISH_AMP_DEADBAND_REL    20      // 2%
+#endif
+#ifndef PUBLISH_TEMP_DEADBAND
+#define PUBLISH_TEMP_DEADBAND       5       // 0.1 C
+#endif
+#ifndef PUBLISH_TEMP_DEADBAND_REL
+#define PUBLISH_TEMP_DEADBAND_REL   0
+#endif
+
+// Readings of a field since it was last sent
+struct PublishStats {
+  long min;
+  long max;
+  int64_t sum;                  // Value * ms
+  uint32_t time;                // ms covered by sum
+  uint16_t count;               // Readings seen
+};
+
+struct PublishFilter {
+  uint8_t sent;                         // Bit per field, has been sent
+  long value[PUBLISH_FIELDS];           // As last sent
+  unsigned long time[PUBLISH_FIELDS];   // millis() when last sent
+
+  PublishStats stats[PUBLISH_FIELDS];
+  long held[PUBLISH_FIELDS];            // Latest reading
+  unsigned long sample_time;            // millis() of the latest reading
+  uint32_t sample_generation;           // Telemetry generation of it
+};
+
+// Add the latest readings to the running stats, call before checking
+// what is due. Calling again for the same snapshot only adds time.
+extern void publish_sample(PublishFilter &filter, const EvseTelemetry &evse);
+
+// Bit mask of the fields due to be sent, 0 if none
+extern uint8_t publish_due(const PublishFilter &filter, const EvseTelemetry &evse);
+
+// Bit mask of the due fields that should not wait for a rate limit: a
+// change of a field with no deadband, such as state or pilot, or a
+// reading outside the deadband that has already gone again
+extern uint8_t publish_urgent(const PublishFilter &filter, const EvseTelemetry &evse);
+
+// Write the fields in mask as "amp:..,amp_max:..,temp1:..,..." as
+// posted to Emoncms, returns the length
+extern int publish_format(const PublishFilter &filter, const EvseTelemetry &evse,
+                          uint8_t fields, char *buf, int size);
+
+// Record the fields in mask as sent and start their stats again
+extern void publish_sent(PublishFilter &filter, const EvseTelemetry &evse, uint8_t fields);
+
+// Forget what has been sent so every field is sent again, e.g. after
+// reconnecting
+extern void publish_reset(PublishFilter &filter);
+
+#endif // _EMONESP_PUBLISH_H
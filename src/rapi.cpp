@@ -0,0 +1,784 @@
+#include "emonesp.h"
+#include "rapi.h"
+#include "debug.h"
+
+#include <Arduino.h>
+
+unsigned long comm_sent = 0;
+unsigned long comm_success = 0;
+unsigned long comm_corrupt = 0;
+unsigned long comm_unmatched = 0;
+unsigned long comm_timeout = 0;
+unsigned long comm_cache_hit = 0;
+unsigned long comm_cache_join = 0;
+unsigned long comm_cache_miss = 0;
+
+static_assert(rapi_checksum("$GE", 3) == 0x26, "RAPI checksum");
+
+#define RAPI_REQUEST_FREE       0
+#define RAPI_REQUEST_QUEUED     1
+#define RAPI_REQUEST_SENT       2   // Waiting for the reply
+#define RAPI_REQUEST_CACHED     3   // To be answered from the cache
+#define RAPI_REQUEST_JOINED     4   // Waiting on an identical request
+
+struct RapiRequest {
+  byte state;
+  byte priority;
+  byte seq;                       // Sequence id while sent, 0 if untagged
+  byte retries;                   // Resends left on a timeout
+  char checksum_type;             // '^' or '*'
+  byte checksum;                  // Checksum of cmd
+  unsigned long order;            // FIFO order within a priority
+  unsigned long timeout;
+  unsigned long sent_time;
+  rapi_callback_t callback;
+  void *ctx;
+  char cmd[RAPI_MAX_COMMAND];     // Without the checksum
+};
+
+static RapiRequest rapi_queue[RAPI_QUEUE_SIZE];
+static unsigned long rapi_order = 0;
+static int rapi_in_flight = 0;
+static byte rapi_seq = 0;
+
+// Sequence ids are echoed by newer firmware. Older firmware would take
+// the tag as part of the command, e.g. as $FP text, so commands go out
+// untagged until a get sent as a probe comes back with its id. Until
+// then replies can only be matched by order so one command is sent at
+// a time.
+static bool rapi_seq_supported = false;
+static bool rapi_seq_probed = false;    // Probe answered without an id
+
+static char rapi_line[RAPI_MAX_REPLY];
+static int rapi_line_len = 0;
+static RapiTokens rapi_tokens;
+
+static rapi_notify_t rapi_notify = NULL;
+
+// -------------------------------------------------------------------
+// Reply cache for $G commands
+//
+// Gets are answered from the last $OK reply to the same command while
+// it is younger than the command's TTL, apart from background polls
+// which would otherwise be answered by their own last reply whenever
+// the TTL is close to the poll interval. Sets and async notifications
+// drop the entries they may have made stale. Only the reply's tokens
+// are kept, each request answered from the cache gets the line built
+// again without the sequence id of the request that read it.
+// -------------------------------------------------------------------
+#define RAPI_CACHE_SIZE         8
+#define RAPI_CACHE_KEY          16
+#define RAPI_CACHE_DEFAULT_TTL  500
+
+struct RapiCacheEntry {
+  unsigned long time;             // millis() of the reply, 0 if unused
+  char cmd[RAPI_CACHE_KEY];
+  char checksum_type;             // Of the reply, 0 if it had none
+  char payload[RAPI_MAX_REPLY];   // Reply without sequence id or checksum
+};
+
+static RapiCacheEntry rapi_cache[RAPI_CACHE_SIZE];
+
+// TTL in ms by the letter after $G, 0 never caches
+static const struct {
+  char cmd;
+  unsigned int ttl;
+} rapi_cache_ttl[] = {
+  { 'S', 500 },     // State
+  { 'G', 500 },     // Charging current
+  { 'U', 1000 },    // Energy usage
+  { 'P', 2000 },    // Temperatures
+  { 'E', 5000 },    // Settings
+  { 'C', 5000 },    // Current capacity
+  { 'A', 5000 },    // Ammeter settings
+  { 'H', 5000 },    // kWh limit
+  { '3', 5000 },    // Time limit
+  { 'F', 5000 },    // Fault counters
+  { 'D', 5000 },    // Delay timer
+  { 'V', 60000 },   // Version
+  { 'T', 0 }        // Time
+};
+
+// The $G commands whose replies each set command can change, by the
+// two letters after the $. Sets not listed drop the whole cache.
+static const struct {
+  char cmd[3];
+  const char *gets;
+} rapi_cache_invalidates[] = {
+  { "SC", "CE" },   // Current capacity
+  { "SL", "CES" },  // Service level
+  { "SD", "E" },    // Diode check
+  { "SE", "E" },    // Echo
+  { "SF", "E" },    // GFI self test
+  { "SG", "E" },    // Ground check
+  { "SR", "E" },    // Stuck relay check
+  { "SS", "E" },    // Temperature check
+  { "SV", "E" },    // Vent required
+  { "SA", "A" },    // Ammeter settings
+  { "SH", "H" },    // kWh limit
+  { "S3", "3" },    // Time limit
+  { "ST", "D" },    // Delay timer
+  { "SK", "U" },    // Accumulated Wh
+  { "S1", "T" },    // Clock
+  { "FE", "S" },    // Enable
+  { "FS", "S" },    // Sleep
+  { "FD", "S" },    // Disable
+  { "FP", "" },     // LCD text
+  { "FB", "" },     // LCD backlight
+  { "F0", "" },     // LCD on/off
+  { "F1", "" }      // Button press
+};
+
+// TTL for cmd, 0 if it is not cached
+static unsigned int
+rapi_cache_get_ttl(const char *cmd) {
+  if ('$' != cmd[0] || 'G' != cmd[1] || '\0' == cmd[2] ||
+      strlen(cmd) >= RAPI_CACHE_KEY) {
+    return 0;
+  }
+  for (unsigned int i = 0; i < sizeof(rapi_cache_ttl) / sizeof(rapi_cache_ttl[0]); i++) {
+    if (rapi_cache_ttl[i].cmd == cmd[2]) {
+      return rapi_cache_ttl[i].ttl;
+    }
+  }
+  return RAPI_CACHE_DEFAULT_TTL;
+}
+
+static RapiCacheEntry *
+rapi_cache_find(const char *cmd) {
+  unsigned int ttl = rapi_cache_get_ttl(cmd);
+  if (0 == ttl) {
+    return NULL;
+  }
+
+  unsigned long now = millis();
+  for (int i = 0; i < RAPI_CACHE_SIZE; i++) {
+    RapiCacheEntry &entry = rapi_cache[i];
+    if (entry.time && 0 == strcmp(entry.cmd, cmd)) {
+      if (now - entry.time < ttl) {
+        return &entry;
+      }
+      entry.time = 0;
+      break;
+    }
+  }
+  return NULL;
+}
+
+// Length of the reply up to its sequence id or checksum
+static int
+rapi_payload_length(const RapiTokens &reply) {
+  return reply.count > 0 ? reply.start[reply.count - 1] + reply.len[reply.count - 1] : 0;
+}
+
+// Build a reply line from a payload, with a checksum of the given type
+// and tokenize it
+static void
+rapi_reply_line(const char *payload, int len, char checksum_type,
+                char *line, RapiTokens &tokens) {
+  len = min(len, RAPI_MAX_REPLY - 4);
+  memcpy(line, payload, len);
+  if (checksum_type) {
+    byte checksum = 0;
+    for (int i = 0; i < len; i++) {
+      checksum = '^' == checksum_type ? checksum ^ line[i] : checksum + line[i];
+    }
+    line[len++] = checksum_type;
+    line[len++] = rapi_hex_char(checksum >> 4);
+    line[len++] = rapi_hex_char(checksum & 0x0F);
+  }
+  line[len] = '\0';
+  rapi_tokenize(line, tokens);
+}
+
+static void
+rapi_cache_store(const char *cmd, const RapiTokens &reply) {
+  if (0 == rapi_cache_get_ttl(cmd)) {
+    return;
+  }
+
+  // Replace the same command, else the oldest entry
+  RapiCacheEntry *slot = &rapi_cache[0];
+  unsigned long now = millis();
+  for (int i = 0; i < RAPI_CACHE_SIZE; i++) {
+    RapiCacheEntry &entry = rapi_cache[i];
+    if (entry.time && 0 == strcmp(entry.cmd, cmd)) {
+      slot = &entry;
+      break;
+    }
+    if (0 == entry.time ||
+        (slot->time && now - entry.time > now - slot->time)) {
+      slot = &entry;
+    }
+  }
+
+  int len = min(rapi_payload_length(reply), (int)sizeof(slot->payload) - 1);
+  strcpy(slot->cmd, cmd);
+  memcpy(slot->payload, reply.line, len);
+  slot->payload[len] = '\0';
+  slot->checksum_type = reply.checksum_type;
+  slot->time = now ? now : 1;
+}
+
+static void
+rapi_cache_drop(char get) {
+  for (int i = 0; i < RAPI_CACHE_SIZE; i++) {
+    if (0 == get || get == rapi_cache[i].cmd[2]) {
+      rapi_cache[i].time = 0;
+    }
+  }
+}
+
+// Drop the entries a command may have changed
+static void
+rapi_cache_invalidate(const char *cmd) {
+  if ('$' != cmd[0] || ('S' != cmd[1] && 'F' != cmd[1]) || '\0' == cmd[2]) {
+    return;
+  }
+  for (unsigned int i = 0; i < sizeof(rapi_cache_invalidates) / sizeof(rapi_cache_invalidates[0]); i++) {
+    if (rapi_cache_invalidates[i].cmd[0] == cmd[1] &&
+        rapi_cache_invalidates[i].cmd[1] == cmd[2]) {
+      for (const char *get = rapi_cache_invalidates[i].gets; *get; get++) {
+        rapi_cache_drop(*get);
+      }
+      return;
+    }
+  }
+  rapi_cache_drop(0);
+}
+
+// -------------------------------------------------------------------
+// RAPI tokenizer
+// -------------------------------------------------------------------
+static int
+rapi_hex_digit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+void
+rapi_tokenize(const char *line, RapiTokens &tokens) {
+  int length = strlen(line);
+
+  tokens.line = line;
+  tokens.checksum_type = 0;
+  tokens.checksum = 0;
+  tokens.has_seq = false;
+  tokens.seq = 0;
+  tokens.count = 0;
+
+  // Strip the ^xx or *xx checksum suffix
+  if (length >= 3 && ('^' == line[length - 3] || '*' == line[length - 3])) {
+    int hi = rapi_hex_digit(line[length - 2]);
+    int lo = rapi_hex_digit(line[length - 1]);
+    if (hi >= 0 && lo >= 0) {
+      tokens.checksum_type = line[length - 3];
+      tokens.checksum = (hi << 4) | lo;
+      length -= 3;
+    }
+  }
+  tokens.length = length;
+
+  int i = 0;
+  while (i < length && tokens.count < RAPI_MAX_TOKENS) {
+    while (i < length && ' ' == line[i]) {
+      i++;
+    }
+    if (i == length) {
+      break;
+    }
+    tokens.start[tokens.count] = i;
+    while (i < length && ' ' != line[i]) {
+      i++;
+    }
+    tokens.len[tokens.count] = i - tokens.start[tokens.count];
+    tokens.count++;
+  }
+
+  // Strip the :xx sequence id, the last token before the checksum
+  if (tokens.count > 1) {
+    const char *p = line + tokens.start[tokens.count - 1];
+    if (3 == tokens.len[tokens.count - 1] && ':' == p[0] &&
+        rapi_hex_digit(p[1]) >= 0 && rapi_hex_digit(p[2]) >= 0) {
+      tokens.has_seq = true;
+      tokens.seq = (rapi_hex_digit(p[1]) << 4) | rapi_hex_digit(p[2]);
+      tokens.count--;
+    }
+  }
+}
+
+bool
+rapi_token_equals(const RapiTokens &tokens, int index, const char *str) {
+  if (index >= tokens.count) {
+    return false;
+  }
+  int len = tokens.len[index];
+  return 0 == strncmp(tokens.line + tokens.start[index], str, len) &&
+         '\0' == str[len];
+}
+
+long
+rapi_token_int(const RapiTokens &tokens, int index, long def) {
+  if (index >= tokens.count) {
+    return def;
+  }
+
+  const char *p = tokens.line + tokens.start[index];
+  const char *end = p + tokens.len[index];
+  bool negative = false;
+  if ('-' == *p) {
+    negative = true;
+    p++;
+  }
+  if (p == end) {
+    return def;
+  }
+
+  long val = 0;
+  for (; p < end; p++) {
+    if (*p < '0' || *p > '9') {
+      return def;
+    }
+    val = val * 10 + (*p - '0');
+  }
+  return negative ? -val : val;
+}
+
+unsigned long
+rapi_token_hex(const RapiTokens &tokens, int index, unsigned long def) {
+  if (index >= tokens.count) {
+    return def;
+  }
+
+  const char *p = tokens.line + tokens.start[index];
+  const char *end = p + tokens.len[index];
+  unsigned long val = 0;
+  for (; p < end; p++) {
+    int digit = rapi_hex_digit(*p);
+    if (digit < 0) {
+      return def;
+    }
+    val = (val << 4) | digit;
+  }
+  return val;
+}
+
+int
+rapi_token_copy(const RapiTokens &tokens, int index, char *buf, int size) {
+  int len = 0;
+  if (index < tokens.count) {
+    len = min((int)tokens.len[index], size - 1);
+    memcpy(buf, tokens.line + tokens.start[index], len);
+  }
+  buf[len] = '\0';
+  return len;
+}
+
+// -------------------------------------------------------------------
+// The request that will send cmd to the OpenEVSE, if there is one
+// -------------------------------------------------------------------
+static RapiRequest *
+rapi_find_leader(const char *cmd) {
+  for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+    RapiRequest &req = rapi_queue[i];
+    if ((RAPI_REQUEST_QUEUED == req.state || RAPI_REQUEST_SENT == req.state) &&
+        0 == strcmp(req.cmd, cmd)) {
+      return &req;
+    }
+  }
+  return NULL;
+}
+
+// Wait on the leader's reply, raising the leader to the joining
+// request's priority so it is not held up behind the leader's place in
+// the queue
+static void
+rapi_join(RapiRequest &req, RapiRequest &leader) {
+  req.state = RAPI_REQUEST_JOINED;
+  if (req.priority < leader.priority) {
+    leader.priority = req.priority;
+  }
+  comm_cache_join++;
+}
+
+// -------------------------------------------------------------------
+// Queue a RAPI command
+//
+// Safe to call from the web server callbacks and from a completion
+// callback, the queue is only walked from rapi_loop().
+// -------------------------------------------------------------------
+bool
+rapi_send(const char *cmd, int priority, rapi_callback_t callback, void *ctx,
+          unsigned long timeout, int retries) {
+  int len = strlen(cmd);
+  char checksum_type = '^';
+  byte checksum = 0;
+  if (len >= 3 && ('^' == cmd[len - 3] || '*' == cmd[len - 3]) &&
+      rapi_hex_digit(cmd[len - 2]) >= 0 && rapi_hex_digit(cmd[len - 1]) >= 0) {
+    // Keep the caller's checksum, the sequence id is added to it on send
+    checksum_type = cmd[len - 3];
+    checksum = (rapi_hex_digit(cmd[len - 2]) << 4) | rapi_hex_digit(cmd[len - 1]);
+    len -= 3;
+  } else {
+    checksum = rapi_checksum(cmd, len);
+  }
+
+  if (RAPI_RETRIES_DEFAULT == retries) {
+    retries = 'G' == cmd[1] ? RAPI_RETRIES : 0;
+  }
+
+  if (len + RAPI_SUFFIX_LEN >= RAPI_MAX_COMMAND) {
+    DBUGF("RAPI command too long: %s", cmd);
+    return false;
+  }
+
+  for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+    RapiRequest &req = rapi_queue[i];
+    if (RAPI_REQUEST_FREE == req.state) {
+      memcpy(req.cmd, cmd, len);
+      req.cmd[len] = '\0';
+      req.priority = priority;
+
+      // Gets are answered from the cache or share a request already
+      // waiting on the OpenEVSE where possible. Background polls are
+      // what keep the cache fresh, so always go to the OpenEVSE.
+      RapiRequest *leader = NULL;
+      if (rapi_cache_get_ttl(req.cmd)) {
+        if (RAPI_PRIORITY_LOW != priority && rapi_cache_find(req.cmd)) {
+          // Answered from rapi_loop() like any other reply
+          req.state = RAPI_REQUEST_CACHED;
+        } else if ((leader = rapi_find_leader(req.cmd))) {
+          rapi_join(req, *leader);
+        } else {
+          comm_cache_miss++;
+        }
+      }
+      if (RAPI_REQUEST_FREE == req.state) {
+        req.state = RAPI_REQUEST_QUEUED;
+      }
+
+      req.order = rapi_order++;
+      req.retries = retries;
+      req.timeout = timeout;
+      req.callback = callback;
+      req.ctx = ctx;
+      req.checksum_type = checksum_type;
+      req.checksum = checksum;
+      return true;
+    }
+  }
+
+  DBUGF("RAPI queue full, dropping %s", cmd);
+  return false;
+}
+
+void
+rapi_cancel(void *ctx) {
+  for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+    RapiRequest &req = rapi_queue[i];
+    if (RAPI_REQUEST_FREE != req.state && req.ctx == ctx) {
+      if (RAPI_REQUEST_SENT == req.state) {
+        // Keep the sequence id until the reply or timeout
+        req.callback = NULL;
+        req.retries = 0;
+      } else {
+        req.state = RAPI_REQUEST_FREE;
+      }
+    }
+  }
+}
+
+// -------------------------------------------------------------------
+// Complete a request, the slot is released before the callback runs
+// so the callback is free to queue further commands
+// -------------------------------------------------------------------
+static void
+rapi_finish(RapiRequest &req, int result, const RapiTokens &reply) {
+  rapi_callback_t callback = req.callback;
+  void *ctx = req.ctx;
+
+  req.state = RAPI_REQUEST_FREE;
+
+  if (callback) {
+    callback(result, reply, ctx);
+  }
+}
+
+// Complete a sent request along with any requests joined to it
+static void
+rapi_complete(RapiRequest &req, int result, const RapiTokens &reply) {
+  rapi_in_flight--;
+
+  if (RAPI_RESULT_TIMEOUT != result) {
+    comm_success++;
+    rapi_cache_invalidate(req.cmd);
+  }
+  if (RAPI_RESULT_OK == result) {
+    rapi_cache_store(req.cmd, reply);
+  }
+
+  // Note the joined requests before the callback can reuse the slot. On
+  // a timeout they are left to be sent in their own right.
+  char cmd[RAPI_CACHE_KEY];
+  bool joined[RAPI_QUEUE_SIZE] = { false };
+  bool has_joined = false;
+  if (RAPI_RESULT_TIMEOUT != result && strlen(req.cmd) < sizeof(cmd)) {
+    strcpy(cmd, req.cmd);
+    for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+      joined[i] = RAPI_REQUEST_JOINED == rapi_queue[i].state &&
+                  0 == strcmp(rapi_queue[i].cmd, cmd);
+      has_joined |= joined[i];
+    }
+  }
+
+  // Callers get the reply without the sequence id, which only belongs
+  // to the transport, so the leader and joined requests see the same line
+  char line[RAPI_MAX_REPLY];
+  RapiTokens answer;
+  if (reply.has_seq) {
+    rapi_reply_line(reply.line, rapi_payload_length(reply), reply.checksum_type,
+                    line, answer);
+  } else {
+    answer = reply;
+  }
+
+  rapi_finish(req, result, answer);
+
+  for (int i = 0; has_joined && i < RAPI_QUEUE_SIZE; i++) {
+    RapiRequest &other = rapi_queue[i];
+    if (joined[i] && RAPI_REQUEST_JOINED == other.state && 0 == strcmp(other.cmd, cmd)) {
+      rapi_finish(other, result, answer);
+    }
+  }
+}
+
+// -------------------------------------------------------------------
+// Find the sent request a reply belongs to
+// -------------------------------------------------------------------
+static RapiRequest *
+rapi_match(const RapiTokens &reply) {
+  if (reply.has_seq) {
+    rapi_seq_supported = true;
+    for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+      RapiRequest &req = rapi_queue[i];
+      if (RAPI_REQUEST_SENT == req.state && req.seq == reply.seq) {
+        return &req;
+      }
+    }
+  } else if (!rapi_seq_supported && 1 == rapi_in_flight) {
+    for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+      if (RAPI_REQUEST_SENT == rapi_queue[i].state) {
+        if (rapi_queue[i].seq) {
+          // The probe was answered without its id
+          rapi_seq_probed = true;
+        }
+        return &rapi_queue[i];
+      }
+    }
+  }
+
+  // Most likely the late reply to a request that has timed out
+  return NULL;
+}
+
+static void
+rapi_process_line() {
+  DBUGF("RAPI < %s", rapi_line);
+
+  rapi_tokenize(rapi_line, rapi_tokens);
+
+  // Replies from older firmware have no checksum, anything else must match
+  if (rapi_tokens.checksum_type) {
+    byte sum = 0;
+    for (int i = 0; i < rapi_tokens.length; i++) {
+      sum = '^' == rapi_tokens.checksum_type ? sum ^ rapi_line[i] : sum + rapi_line[i];
+    }
+    if (sum != rapi_tokens.checksum) {
+      DBUGF("RAPI bad checksum: %s", rapi_line);
+      comm_corrupt++;
+      return;
+    }
+  }
+
+  bool ok = rapi_token_equals(rapi_tokens, 0, "$OK");
+  bool nk = rapi_token_equals(rapi_tokens, 0, "$NK");
+  if (ok || nk) {
+    RapiRequest *req = rapi_match(rapi_tokens);
+    if (req) {
+      rapi_complete(*req, ok ? RAPI_RESULT_OK : RAPI_RESULT_NK, rapi_tokens);
+    } else {
+      DBUGF("RAPI unmatched reply: %s", rapi_line);
+      comm_unmatched++;
+    }
+  } else if ('$' == rapi_line[0]) {
+    // The OpenEVSE has changed on its own, cached replies can't be trusted
+    rapi_cache_drop(0);
+    if (rapi_notify) {
+      rapi_notify(rapi_tokens);
+    }
+  }
+}
+
+static void
+rapi_read() {
+  while (Serial.available()) {
+    int c = Serial.read();
+    if ('\r' == c) {
+      rapi_line[rapi_line_len] = '\0';
+      if (rapi_line_len > 0) {
+        rapi_process_line();
+      }
+      rapi_line_len = 0;
+    } else if ('\n' == c) {
+      continue;
+    } else {
+      if ('$' == c) {
+        // Start of a new message, drop any partial garbage
+        rapi_line_len = 0;
+      }
+      if (rapi_line_len < RAPI_MAX_REPLY - 1) {
+        rapi_line[rapi_line_len++] = (char)c;
+      }
+    }
+  }
+}
+
+// -------------------------------------------------------------------
+// Send a request, tagged with the next free sequence id if the
+// OpenEVSE echoes them or this is a get that can probe for it
+// -------------------------------------------------------------------
+static void
+rapi_transmit(RapiRequest &req) {
+  char buf[RAPI_MAX_COMMAND];
+  req.seq = 0;
+  if (rapi_seq_supported || (!rapi_seq_probed && 'G' == req.cmd[1])) {
+    bool used;
+    do {
+      rapi_seq = rapi_seq < 0xFF ? rapi_seq + 1 : 1;
+      used = false;
+      for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+        used |= RAPI_REQUEST_SENT == rapi_queue[i].state &&
+                rapi_seq == rapi_queue[i].seq;
+      }
+    } while (used);
+    req.seq = rapi_seq;
+
+    // Add " :xx" to the command and its checksum
+    char tag[5] = { ' ', ':', rapi_hex_char(rapi_seq >> 4), rapi_hex_char(rapi_seq & 0x0F), '\0' };
+    byte checksum = req.checksum;
+    for (int i = 0; i < 4; i++) {
+      checksum = '^' == req.checksum_type ? checksum ^ tag[i] : checksum + tag[i];
+    }
+    snprintf(buf, sizeof(buf), "%s%s%c%c%c", req.cmd, tag, req.checksum_type,
+             rapi_hex_char(checksum >> 4), rapi_hex_char(checksum & 0x0F));
+  } else {
+    snprintf(buf, sizeof(buf), "%s%c%c%c", req.cmd, req.checksum_type,
+             rapi_hex_char(req.checksum >> 4), rapi_hex_char(req.checksum & 0x0F));
+  }
+  DBUGF("RAPI > %s", buf);
+  Serial.println(buf);
+  comm_sent++;
+
+  req.state = RAPI_REQUEST_SENT;
+  req.sent_time = millis();
+  rapi_in_flight++;
+}
+
+static void
+rapi_dispatch() {
+  int max_in_flight = rapi_seq_supported ? RAPI_MAX_IN_FLIGHT : 1;
+  while (rapi_in_flight < max_in_flight) {
+    int next = -1;
+    for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+      RapiRequest &req = rapi_queue[i];
+      if (RAPI_REQUEST_QUEUED == req.state &&
+          (-1 == next ||
+           req.priority < rapi_queue[next].priority ||
+           (req.priority == rapi_queue[next].priority &&
+            (long)(req.order - rapi_queue[next].order) < 0))) {
+        next = i;
+      }
+    }
+
+    if (-1 == next) {
+      break;
+    }
+    rapi_transmit(rapi_queue[next]);
+  }
+}
+
+// -------------------------------------------------------------------
+// Resend or fail requests that have not been answered in time
+// -------------------------------------------------------------------
+static void
+rapi_check_timeouts() {
+  unsigned long now = millis();
+  for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+    RapiRequest &req = rapi_queue[i];
+    if (RAPI_REQUEST_SENT == req.state && (now - req.sent_time) >= req.timeout) {
+      DBUGF("RAPI timeout: %s :%02X", req.cmd, req.seq);
+      comm_timeout++;
+      if (req.retries > 0) {
+        // Back in the queue ahead of anything else at its priority
+        req.retries--;
+        req.state = RAPI_REQUEST_QUEUED;
+        rapi_in_flight--;
+      } else {
+        rapi_tokenize("", rapi_tokens);
+        rapi_complete(req, RAPI_RESULT_TIMEOUT, rapi_tokens);
+      }
+    }
+  }
+}
+
+// -------------------------------------------------------------------
+// Answer requests from the cache. Requests whose entry has expired, or
+// whose leader was cancelled or timed out, go to the OpenEVSE.
+// -------------------------------------------------------------------
+static void
+rapi_check_cached() {
+  for (int i = 0; i < RAPI_QUEUE_SIZE; i++) {
+    RapiRequest &req = rapi_queue[i];
+    if (RAPI_REQUEST_CACHED == req.state) {
+      RapiCacheEntry *entry = rapi_cache_find(req.cmd);
+      if (entry) {
+        comm_cache_hit++;
+        char line[RAPI_MAX_REPLY];
+        RapiTokens reply;
+        rapi_reply_line(entry->payload, strlen(entry->payload), entry->checksum_type,
+                        line, reply);
+        rapi_finish(req, RAPI_RESULT_OK, reply);
+        continue;
+      }
+      RapiRequest *leader = rapi_find_leader(req.cmd);
+      if (leader) {
+        rapi_join(req, *leader);
+      } else {
+        req.state = RAPI_REQUEST_QUEUED;
+        comm_cache_miss++;
+      }
+    } else if (RAPI_REQUEST_JOINED == req.state && !rapi_find_leader(req.cmd)) {
+      req.state = RAPI_REQUEST_QUEUED;
+    }
+  }
+}
+
+void
+rapi_on_notify(rapi_notify_t handler) {
+  rapi_notify = handler;
+}
+
+// -------------------------------------------------------------------
+// RAPI state management
+//
+// Call every time around loop(), never blocks
+// -------------------------------------------------------------------
+void
+rapi_loop() {
+  rapi_read();
+  rapi_check_timeouts();
+  rapi_check_cached();
+  rapi_dispatch();
+}
@@ -0,0 +1,160 @@
+#ifndef _EMONESP_RAPI_H
+#define _EMONESP_RAPI_H
+
+#include <Arduino.h>
+
+// -------------------------------------------------------------------
+// RAPI transport
+//
+// Owns the serial link to the OpenEVSE. Commands are queued, sent in
+// priority order and completed through a callback once the $OK/$NK
+// reply arrives or the request times out.
+//
+// Once the OpenEVSE has been seen to echo them, each command is sent
+// with a RAPI sequence id (" :xx" before the checksum) and a reply is
+// only given to the request whose id it echoes. Until then, and for
+// older firmware that does not, commands go out untagged apart from a
+// $G probe, a single command is in flight at a time and the reply is
+// matched by order. Callbacks get the reply line without the id.
+//
+// $G commands other than background polls (RAPI_PRIORITY_LOW) are
+// answered from a short lived cache of earlier replies when possible,
+// and any get shares the request of an identical get that is already
+// waiting on the OpenEVSE.
+// -------------------------------------------------------------------
+
+// Request priorities, lower values are sent first
+#define RAPI_PRIORITY_HIGH      0   // Web/MQTT passthrough and control commands
+#define RAPI_PRIORITY_LOW       1   // Background polling
+
+// Completion results
+#define RAPI_RESULT_OK          0   // $OK reply
+#define RAPI_RESULT_NK          1   // $NK reply
+#define RAPI_RESULT_TIMEOUT     2   // No reply within RAPI_TIMEOUT
+
+#define RAPI_QUEUE_SIZE         10
+#define RAPI_MAX_COMMAND        48
+#define RAPI_MAX_REPLY          64
+#define RAPI_MAX_TOKENS         8
+#define RAPI_MAX_IN_FLIGHT      3     // Once the OpenEVSE echoes sequence ids
+#define RAPI_TIMEOUT            1000  // Default ms to wait for a reply
+#define RAPI_RETRIES            1     // Default resends of a get after a timeout
+#define RAPI_RETRIES_DEFAULT    -1    // RAPI_RETRIES for gets, none for others
+#define RAPI_SUFFIX_LEN         7     // " :xx^xx" added to each command
+
+// -------------------------------------------------------------------
+// A RAPI line split into space separated tokens, token 0 is the
+// command or $OK/$NK. Tokens are offsets into line, which is never
+// modified or copied, so parsing a reply does not touch the heap.
+// -------------------------------------------------------------------
+struct RapiTokens {
+  const char *line;       // The raw line
+  byte length;            // Length of line without the checksum suffix
+  char checksum_type;     // '^' (XOR), '*' (sum) or 0 if none
+  byte checksum;          // Checksum value from the suffix
+  bool has_seq;           // Ended with a :xx sequence id
+  byte seq;               // Sequence id, not counted as a token
+  byte count;             // Number of tokens
+  byte start[RAPI_MAX_TOKENS];
+  byte len[RAPI_MAX_TOKENS];
+};
+
+extern void rapi_tokenize(const char *line, RapiTokens &tokens);
+extern bool rapi_token_equals(const RapiTokens &tokens, int index, const char *str);
+extern long rapi_token_int(const RapiTokens &tokens, int index, long def = 0);
+extern unsigned long rapi_token_hex(const RapiTokens &tokens, int index, unsigned long def = 0);
+// Copy a token as a C string, returns its length
+extern int rapi_token_copy(const RapiTokens &tokens, int index, char *buf, int size);
+
+// -------------------------------------------------------------------
+// RAPI command builder
+//
+// RAPI commands carry an XOR checksum of everything before the '^',
+// e.g. "$GE^26". rapi_command("$GE") builds the full command at compile
+// time so fixed commands cost nothing at runtime:
+//
+//   static constexpr auto get_state = rapi_command("$GS");
+//   rapi_send(get_state.str, ...);
+//
+// Commands queued without a checksum, such as parameterised or
+// passthrough commands, get one computed by rapi_send().
+// -------------------------------------------------------------------
+constexpr byte
+rapi_checksum(const char *cmd, unsigned int len) {
+  return len > 0 ? (byte)(cmd[0] ^ rapi_checksum(cmd + 1, len - 1)) : 0;
+}
+
+constexpr char
+rapi_hex_char(byte nibble) {
+  return nibble < 10 ? '0' + nibble : 'A' + nibble - 10;
+}
+
+template <unsigned int N>
+struct RapiCommand {
+  char str[N];
+};
+
+template <unsigned int... I>
+struct RapiIndices {};
+
+template <unsigned int N, unsigned int... I>
+struct RapiMakeIndices : RapiMakeIndices<N - 1, N - 1, I...> {};
+
+template <unsigned int... I>
+struct RapiMakeIndices<0, I...> {
+  typedef RapiIndices<I...> type;
+};
+
+template <unsigned int N, unsigned int... I>
+constexpr RapiCommand<N + 3>
+rapi_command(const char (&cmd)[N], RapiIndices<I...>) {
+  return RapiCommand<N + 3> {{
+    cmd[I]..., '^',
+    rapi_hex_char(rapi_checksum(cmd, N - 1) >> 4),
+    rapi_hex_char(rapi_checksum(cmd, N - 1) & 0x0F),
+    '\0'
+  }};
+}
+
+template <unsigned int N>
+constexpr RapiCommand<N + 3>
+rapi_command(const char (&cmd)[N]) {
+  return rapi_command(cmd, typename RapiMakeIndices<N - 1>::type());
+}
+
+// Called from rapi_loop() when a request completes. reply holds the
+// tokenized reply line (no tokens on timeout) and is only valid during
+// the call.
+typedef void (*rapi_callback_t)(int result, const RapiTokens &reply, void *ctx);
+
+// Called from rapi_loop() for unsolicited lines from the OpenEVSE, such
+// as the $ST/$AT state notifications of newer firmware
+typedef void (*rapi_notify_t)(const RapiTokens &notification);
+
+extern unsigned long comm_sent;
+extern unsigned long comm_success;
+extern unsigned long comm_corrupt;      // Replies dropped on a bad checksum
+extern unsigned long comm_unmatched;    // Replies with no request waiting
+extern unsigned long comm_timeout;      // Requests not answered in time
+extern unsigned long comm_cache_hit;    // Gets answered from the cache
+extern unsigned long comm_cache_join;   // Gets that shared a request
+extern unsigned long comm_cache_miss;   // Gets sent to the OpenEVSE
+
+// Queue a command, returns false if the queue is full. The command is
+// resent up to retries times if there is no reply within timeout ms.
+// By default only $G commands are resent, anything else may have been
+// acted on even though its reply was lost, e.g. $FR or $F1.
+extern bool rapi_send(const char *cmd, int priority,
+                      rapi_callback_t callback = NULL, void *ctx = NULL,
+                      unsigned long timeout = RAPI_TIMEOUT,
+                      int retries = RAPI_RETRIES_DEFAULT);
+
+// Drop all requests queued with ctx, their callbacks will not be called
+extern void rapi_cancel(void *ctx);
+
+// Set the handler for async notifications
+extern void rapi_on_notify(rapi_notify_t handler);
+
+extern void rapi_loop();
+
+#endif // _EMONESP_RAPI_H
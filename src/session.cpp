@@ -0,0 +1,185 @@
+#include "emonesp.h"
+#include "session.h"
+#include "input.h"
+#include "debug.h"
+
+#include <Arduino.h>
+#include <FS.h>
+
+#define SESSION_JOURNAL "/sessions.bin"
+
+static_assert(sizeof(SessionRecord) == 32, "Journal records are 32 bytes");
+
+static uint32_t session_last = 0;
+
+static bool session_active = false;
+static SessionRecord session;
+static unsigned long session_start_millis = 0;
+static unsigned long session_tick = 0;          // millis() of the last sample
+static uint64_t session_amp_sum = 0;            // 10 mA seconds while charging
+static uint32_t session_wattsec = 0;           // Energy this session
+static uint32_t session_wattsec_read = 0;      // Last $GU wattsec
+static long session_state = 0;
+
+uint32_t
+session_last_id() {
+  return session_last;
+}
+
+bool
+session_read(uint32_t id, SessionRecord &record) {
+  if (0 == id || id > session_last || session_last - id >= SESSION_JOURNAL_SIZE) {
+    return false;
+  }
+
+  File file = SPIFFS.open(SESSION_JOURNAL, "r");
+  if (!file) {
+    return false;
+  }
+  bool found = file.seek(((id - 1) % SESSION_JOURNAL_SIZE) * sizeof(record), SeekSet) &&
+               sizeof(record) == file.read((uint8_t *)&record, sizeof(record)) &&
+               record.id == id;
+  file.close();
+  return found;
+}
+
+bool
+session_current(SessionRecord &record) {
+  if (!session_active) {
+    return false;
+  }
+
+  record = session;
+  record.duration = (millis() - session_start_millis) / 1000;
+  record.amp_avg = session.charge_time ? session_amp_sum / session.charge_time : 0;
+  record.wh = session_wattsec / 3600;
+  return true;
+}
+
+int
+session_format(const SessionRecord &record, bool active, char *buf, int size) {
+  return snprintf(buf, size,
+                  "{\"id\":%u,\"active\":%s,\"partial\":%s,\"start\":%u,\"end\":%u,"
+                  "\"duration\":%u,\"charge_time\":%u,\"wh\":%u,"
+                  "\"amp_peak\":%u,\"amp_avg\":%u,\"temp_max\":%d}",
+                  record.id, active ? "true" : "false",
+                  (record.flags & SESSION_FLAG_PARTIAL) ? "true" : "false",
+                  record.start_time, record.end_time, record.duration,
+                  record.charge_time, record.wh,
+                  record.amp_peak * 10, record.amp_avg * 10, record.temp_max);
+}
+
+// -------------------------------------------------------------------
+// Write a completed session to its slot in the journal
+// -------------------------------------------------------------------
+static void
+session_write(const SessionRecord &record) {
+  uint32_t offset = ((record.id - 1) % SESSION_JOURNAL_SIZE) * sizeof(record);
+  File file = SPIFFS.open(SESSION_JOURNAL, SPIFFS.exists(SESSION_JOURNAL) ? "r+" : "w");
+  if (!file) {
+    DBUGLN("Session journal can not be opened");
+    return;
+  }
+  // Slots are filled in order so the file is never short of offset
+  if (file.seek(min((uint32_t)file.size(), offset), SeekSet)) {
+    file.write((const uint8_t *)&record, sizeof(record));
+  }
+  file.close();
+}
+
+static void
+session_start(bool partial) {
+  memset(&session, 0, sizeof(session));
+  session.id = session_last + 1;
+  session.start_time = input_time();
+  session.flags = partial ? SESSION_FLAG_PARTIAL : 0;
+  session.temp_max = INT16_MIN;
+  session_start_millis = millis();
+  session_tick = session_start_millis;
+  session_amp_sum = 0;
+  session_wattsec = 0;
+  EvseTelemetry evse;
+  input_snapshot(evse);
+  session_wattsec_read = evse.wattsec;
+  session_active = true;
+  DBUGF("Session %u started", session.id);
+}
+
+static void
+session_end() {
+  SessionRecord record;
+  session_current(record);
+  record.end_time = input_time();
+  if (INT16_MIN == record.temp_max) {
+    record.temp_max = 0;
+  }
+
+  session_write(record);
+  session_last = record.id;
+  session_active = false;
+  DBUGF("Session %u ended, %u Wh", record.id, record.wh);
+}
+
+// -------------------------------------------------------------------
+// State change subscriber
+// -------------------------------------------------------------------
+void
+session_state_changed(long state, const char *estate) {
+  long previous = session_state;
+  session_state = state;
+
+  if (!session_active && (2 == state || 3 == state)) {
+    // Coming from an unknown state the EV was connected before boot
+    session_start(0 == previous);
+  } else if (session_active && 1 == state) {
+    session_end();
+  }
+}
+
+// -------------------------------------------------------------------
+// Find the last session in the journal
+// -------------------------------------------------------------------
+void
+session_setup() {
+  File file = SPIFFS.open(SESSION_JOURNAL, "r");
+  if (file) {
+    SessionRecord record;
+    while (sizeof(record) == file.read((uint8_t *)&record, sizeof(record))) {
+      session_last = max(session_last, record.id);
+    }
+    file.close();
+  }
+  DBUGF("Last session %u", session_last);
+}
+
+// -------------------------------------------------------------------
+// Sample the session in progress once a second
+// -------------------------------------------------------------------
+void
+session_loop() {
+  if (!session_active || (millis() - session_tick) < 1000) {
+    return;
+  }
+  session_tick += 1000;
+
+  EvseTelemetry evse;
+  input_snapshot(evse);
+
+  uint16_t amp = evse.amp > 0 ? evse.amp / 10 : 0;
+  session.amp_peak = max(session.amp_peak, amp);
+  if (3 == evse.state) {
+    session.charge_time++;
+    session_amp_sum += amp;
+  }
+  session.temp_max = max(session.temp_max, max(evse.temp1, max(evse.temp2, evse.temp3)));
+
+  // The OpenEVSE counts the energy of the current charge, going back
+  // to 0 as one starts. The value at the start of the session may be
+  // left over from the last one so only increases are counted.
+  if (evse.wattsec >= session_wattsec_read) {
+    session_wattsec += evse.wattsec - session_wattsec_read;
+  } else {
+    session_wattsec += evse.wattsec;
+  }
+  session_wattsec_read = evse.wattsec;
+}
@@ -0,0 +1,47 @@
+#ifndef _EMONESP_SESSION_H
+#define _EMONESP_SESSION_H
+
+#include <Arduino.h>
+
+// -------------------------------------------------------------------
+// Charging sessions
+//
+// A session runs from the EV being connected (EV_Connected or Charging)
+// until the OpenEVSE is back to Not_Connected. Completed sessions are
+// kept in a journal of fixed size records in SPIFFS, the last
+// SESSION_JOURNAL_SIZE are kept.
+// -------------------------------------------------------------------
+#ifndef SESSION_JOURNAL_SIZE
+#define SESSION_JOURNAL_SIZE  50
+#endif
+
+#define SESSION_FLAG_PARTIAL  0x01    // Already connected at boot
+
+struct SessionRecord {
+  uint32_t id;                  // Numbered from 1
+  uint32_t start_time;          // Unix time, 0 if the OpenEVSE has no clock
+  uint32_t end_time;
+  uint32_t duration;            // s connected
+  uint32_t charge_time;         // s charging
+  uint32_t wh;                  // Energy delivered
+  uint16_t amp_peak;            // 10 mA
+  uint16_t amp_avg;             // 10 mA, over the charge time
+  int16_t temp_max;             // 0.1 C
+  uint8_t flags;                // SESSION_FLAG_*
+  uint8_t reserved;
+};
+
+// id of the last completed session, 0 if none
+extern uint32_t session_last_id();
+// Read a completed session, false if it is no longer in the journal
+extern bool session_read(uint32_t id, SessionRecord &record);
+// The session in progress, false if the EV is not connected
+extern bool session_current(SessionRecord &record);
+// Write a session as a JSON object, returns the length
+extern int session_format(const SessionRecord &record, bool active, char *buf, int size);
+
+extern void session_state_changed(long state, const char *estate);
+extern void session_setup();
+extern void session_loop();
+
+#endif // _EMONESP_SESSION_H
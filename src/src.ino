@@ -35,17 +35,21 @@
 #include "input.h"
 #include "emoncms.h"
 #include "mqtt.h"
+#include "rapi.h"
+#include "history.h"
+#include "datalog.h"
+#include "session.h"
+#include "publish.h"
 
-unsigned long Timer1; // Timer for events once every 30 seconds
+unsigned long Timer1; // Timer for publishing heartbeats
 unsigned long Timer2; // Timer for events once every 1 Minute
-unsigned long Timer3; // Timer for events once every 5 seconds
+uint32_t publish_generation = 0; // Telemetry last checked for changes
 
 // -------------------------------------------------------------------
 // SETUP
 // -------------------------------------------------------------------
 void
 setup() {
-  delay(2000);
   Serial.begin(115200);
   pinMode(0, INPUT);
   espflash = ESP.getFlashChipSize();
@@ -60,10 +64,16 @@ setup() {
   DEBUG.println(ESP.getChipId());
   DEBUG.println("Firmware: " + currentfirmware);
 
+  // Nothing here waits on the network or the OpenEVSE. WiFi connects
+  // from wifi_loop() and the RAPI values are read in the background,
+  // retrying until the OpenEVSE has finished its self test.
   config_load_settings();
-  wifi_setup();
   web_server_setup();
-  delay(5000); //gives OpenEVSE time to finish self test on cold start
+  wifi_setup();
+  input_setup();
+  datalog_setup();
+  session_setup();
+  input_subscribe_state(session_state_changed);
   handleRapiRead(); //Read all RAPI values
 #ifdef ENABLE_OTA
   // Start local OTA update server
@@ -78,6 +88,12 @@ setup() {
 void
 loop() {
   // ota_loop();
+  rapi_loop();
+  update_rapi_values();
+  history_loop();
+  datalog_loop();
+  session_loop();
+  config_loop();
   web_server_loop();
   wifi_loop();
 
@@ -85,17 +101,10 @@ loop() {
   ArduinoOTA.handle();
 #endif
 
-  if (mqtt_server != 0)
-    mqtt_loop();
+  if (wifi_client_connected()) {
+    if (config_mqtt_server()[0])
+      mqtt_loop();
 
-  if (wifi_mode == WIFI_MODE_STA || wifi_mode == WIFI_MODE_AP_AND_STA) {
-// -------------------------------------------------------------------
-// Do these things once every 5s
-// -------------------------------------------------------------------
-    if ((millis() - Timer3) >= 5000) {
-      update_rapi_values();
-      Timer3 = millis();
-    }
 // -------------------------------------------------------------------
 // Do these things once every Minute
 // -------------------------------------------------------------------
@@ -104,15 +113,22 @@ loop() {
       Timer2 = millis();
     }
 // -------------------------------------------------------------------
-// Do these things once every 30 seconds
+// Publish to EmonCMS and MQTT as soon as the values change, checking
+// once a second for fields due a heartbeat
 // -------------------------------------------------------------------
-    if ((millis() - Timer1) >= 30000) {
-      create_rapi_json(); // create JSON Strings for EmonCMS and MQTT
-      if (emoncms_apikey != 0)
-        emoncms_publish(url);
+    if (input_generation() != publish_generation || (millis() - Timer1) >= 1000) {
+      // EmonCMS and MQTT both publish from the same snapshot
+      EvseTelemetry evse;
+      input_snapshot(evse);
+      publish_generation = evse.generation;
+      // Nothing to publish until the OpenEVSE has been read
+      if (evse.state != 0) {
+        if (config_emoncms_apikey()[0])
+          emoncms_publish(evse);
+        if (config_mqtt_server()[0])
+          mqtt_publish(evse);
+      }
       Timer1 = millis();
-      if (mqtt_server != 0)
-        mqtt_publish(data);
     }
   } // end WiFi connected
 } // end loop
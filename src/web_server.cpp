@@ -5,10 +5,18 @@
 #include "emonesp.h"
 #include "web_server.h"
 #include "config.h"
+#include "config_store.h"
 #include "wifi.h"
 #include "mqtt.h"
 #include "input.h"
 #include "emoncms.h"
+#include "rapi.h"
+#include "json.h"
+#include "history.h"
+#include "datalog.h"
+#include "session.h"
+#include "events.h"
+#include "assets.h"
 //#include "ota.h"
 #include "debug.h"
 
@@ -22,6 +30,14 @@ unsigned long mqttRestartTime = 0;
 unsigned long systemRestartTime = 0;
 unsigned long systemRebootTime = 0;
 
+// millis() when the first HTTP request was answered, 0 until then
+unsigned long firstResponseTime = 0;
+
+// Heap taken by building a reply: free heap when the request started,
+// and the most any reply has taken, reported in /status
+static uint32_t requestFreeHeap = 0;
+static uint32_t replyHeapPeak = 0;
+
 // Get running firmware version from build tag environment variable
 #define TEXTIFY(A) #A
 #define ESCAPEQUOTE(A) TEXTIFY(A)
@@ -30,37 +46,250 @@ String currentfirmware = ESCAPEQUOTE(BUILD_TAG);
 // -------------------------------------------------------------------
 // Helper function to perform the standard operations on a request
 // -------------------------------------------------------------------
-bool requestPreProcess(AsyncWebServerRequest *request, AsyncResponseStream *&response, const char *contentType = "application/json")
+bool requestAuthenticate(AsyncWebServerRequest *request)
 {
-  if(www_username!="" && !request->authenticate(www_username.c_str(), www_password.c_str())) {
+  if(config_www_username()[0] && !request->authenticate(config_www_username(), config_www_password())) {
     request->requestAuthentication();
     return false;
   }
 
-  response = request->beginResponseStream(contentType);
+  if(0 == firstResponseTime) {
+    firstResponseTime = millis();
+  }
+
+  return true;
+}
+
+AsyncResponseStream *requestBeginResponse(AsyncWebServerRequest *request, const char *contentType)
+{
+  requestFreeHeap = ESP.getFreeHeap();
+  AsyncResponseStream *response = request->beginResponseStream(contentType);
   if(enableCors) {
     response->addHeader("Access-Control-Allow-Origin", "*");
   }
+  return response;
+}
+
+bool requestPreProcess(AsyncWebServerRequest *request, AsyncResponseStream *&response, const char *contentType = "application/json")
+{
+  if(false == requestAuthenticate(request)) {
+    return false;
+  }
 
+  response = requestBeginResponse(request, contentType);
   return true;
 }
 
+// -------------------------------------------------------------------
+// Send a reply started by requestPreProcess(), noting the heap it took
+// -------------------------------------------------------------------
+void requestSend(AsyncWebServerRequest *request, AsyncResponseStream *response)
+{
+  uint32_t freeHeap = ESP.getFreeHeap();
+  if(requestFreeHeap > freeHeap) {
+    replyHeapPeak = max(replyHeapPeak, requestFreeHeap - freeHeap);
+  }
+  request->send(response);
+}
+
+// -------------------------------------------------------------------
+// JSON bodies must be sent as application/json, the server parses form
+// encoded bodies into params and never hands them to the body callback.
+// Sends 415 and returns false for anything else.
+// -------------------------------------------------------------------
+bool requestExpectJson(AsyncWebServerRequest *request, AsyncResponseStream *response)
+{
+  if(request->contentType().startsWith("application/json")) {
+    return true;
+  }
+  delete response;
+  request->send(415, "text/plain", "Expected Content-Type: application/json");
+  return false;
+}
+
+// -------------------------------------------------------------------
+// Collect a POST body of up to maxSize bytes, nul terminated, in
+// request->_tempObject, which is left NULL if it is too big
+// -------------------------------------------------------------------
+void requestReadBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total, size_t maxSize)
+{
+  if(total > maxSize) {
+    return;
+  }
+  if(0 == index) {
+    request->_tempObject = malloc(total + 1);
+  }
+  if(NULL != request->_tempObject) {
+    char *body = (char *)request->_tempObject;
+    memcpy(body + index, data, len);
+    body[index + len] = '\0';
+  }
+}
+
+// -------------------------------------------------------------------
+// A rendered JSON reply, kept until what it was rendered from changes
+//
+// The key is a counter that changes whenever the data behind the reply
+// does, e.g. the telemetry generation. The ETag is a hash of the body,
+// so it only changes when the body does however often it is rendered,
+// and stays valid across restarts.
+// -------------------------------------------------------------------
+typedef void (*reply_render_t)(JsonWriter &json);
+
+class ReplyCache : public Print {
+  public:
+    ReplyCache(reply_render_t render, unsigned long maxAge) :
+      render(render), maxAge(maxAge), body(NULL), len(0), size(0),
+      key(0), time(0), valid(false), failed(false)
+    {
+      etag[0] = '\0';
+    }
+
+    // Render again if key has changed or the body is older than maxAge,
+    // false if the body could not be held
+    bool update(uint32_t newKey) {
+      if(valid && newKey == key && (0 == maxAge || (millis() - time) < maxAge)) {
+        return true;
+      }
+
+      len = 0;
+      hash = 2166136261UL;      // FNV-1a
+      failed = false;
+      JsonWriter json(*this);
+      render(json);
+      valid = !failed;
+      if(valid) {
+        key = newKey;
+        time = millis();
+        snprintf(etag, sizeof(etag), "\"%08x-%x\"", (unsigned int)hash, (unsigned int)len);
+      }
+      return valid;
+    }
+
+    size_t write(uint8_t c) {
+      return write(&c, 1);
+    }
+
+    size_t write(const uint8_t *data, size_t count) {
+      if(len + count > size) {
+        size_t newSize = max(size * 2, len + count + 64);
+        char *newBody = (char *)realloc(body, newSize);
+        if(NULL == newBody) {
+          failed = true;
+          return 0;
+        }
+        body = newBody;
+        size = newSize;
+      }
+      memcpy(body + len, data, count);
+      len += count;
+      for(size_t i = 0; i < count; i++) {
+        hash = (hash ^ data[i]) * 16777619UL;
+      }
+      return count;
+    }
+
+    reply_render_t render;
+    unsigned long maxAge;       // ms, 0 for as long as the key holds
+    char *body;
+    size_t len;
+    char etag[20];
+
+  private:
+    size_t size;
+    uint32_t key;
+    unsigned long time;         // millis() when rendered
+    uint32_t hash;
+    bool valid;
+    bool failed;
+};
+
+// -------------------------------------------------------------------
+// Send a cached reply, or 304 Not Modified if the client already has it
+// -------------------------------------------------------------------
+void requestSendCached(AsyncWebServerRequest *request, ReplyCache &cache, uint32_t key)
+{
+  if(false == requestAuthenticate(request)) {
+    return;
+  }
+
+  bool cached = cache.update(key);
+  if(cached && request->hasHeader("If-None-Match") &&
+     request->getHeader("If-None-Match")->value() == cache.etag) {
+    AsyncWebServerResponse *response = request->beginResponse(304);
+    response->addHeader("ETag", cache.etag);
+    if(enableCors) {
+      response->addHeader("Access-Control-Allow-Origin", "*");
+    }
+    request->send(response);
+    return;
+  }
+
+  AsyncResponseStream *response = requestBeginResponse(request, "application/json");
+  if(cached) {
+    response->write((const uint8_t *)cache.body, cache.len);
+    response->addHeader("ETag", cache.etag);
+    // Check with us each time, the ETag makes that cheap
+    response->addHeader("Cache-Control", "no-cache");
+  } else {
+    // Out of heap to hold it, render straight into the reply
+    JsonWriter json(*response);
+    cache.render(json);
+  }
+
+  response->setCode(200);
+  requestSend(request, response);
+}
+
+// -------------------------------------------------------------------
+// Handles GET url, for replies sent with requestSendCached()
+//
+// Added with addHandler() rather than server.on() so If-None-Match
+// reaches the request, the server drops any header no handler has
+// asked for in canHandle().
+// -------------------------------------------------------------------
+class CachedReplyHandler : public AsyncWebHandler {
+  public:
+    CachedReplyHandler(const char *url, ArRequestHandlerFunction onRequest) :
+      url(url), onRequest(onRequest)
+    {
+    }
+
+    bool canHandle(AsyncWebServerRequest *request) {
+      if(HTTP_GET != request->method() || request->url() != url) {
+        return false;
+      }
+      request->addInterestingHeader("If-None-Match");
+      return true;
+    }
+
+    void handleRequest(AsyncWebServerRequest *request) {
+      onRequest(request);
+    }
+
+  private:
+    const char *url;
+    ArRequestHandlerFunction onRequest;
+};
+
 // -------------------------------------------------------------------
 // Load Home page
 // url: /
 // -------------------------------------------------------------------
 void
 handleHome(AsyncWebServerRequest *request) {
-  if (www_username != ""
-      && !request->authenticate(www_username.c_str(),
-                              www_password.c_str())
+  if (config_www_username()[0]
+      && !request->authenticate(config_www_username(),
+                              config_www_password())
       && wifi_mode == WIFI_MODE_STA) {
     return request->requestAuthentication();
   }
 
-  if (SPIFFS.exists("/home.html")) {
-    request->send(SPIFFS, "/home.html");
-  } else {
+  if (0 == firstResponseTime) {
+    firstResponseTime = millis();
+  }
+
+  if (!assets_send(request, "/home.html")) {
     request->send(200, "text/plain",
                   "/home.html not found, have you flashed the SPIFFS?");
   }
@@ -76,33 +305,35 @@ handleHome(AsyncWebServerRequest *request) {
 void
 handleScan(AsyncWebServerRequest *request) {
   AsyncResponseStream *response;
-  if(false == requestPreProcess(request, response)) {
+  if(false == requestPreProcess(request, response, "text/json")) {
     return;
   }
 
-  String json = "[";
+  JsonWriter json(*response);
+  json.begin_array();
   int n = WiFi.scanComplete();
   if(n == -2) {
     WiFi.scanNetworks(true);
   } else if(n) {
     for (int i = 0; i < n; ++i) {
-      if(i) json += ",";
-      json += "{";
-      json += "\"rssi\":"+String(WiFi.RSSI(i));
-      json += ",\"ssid\":\""+WiFi.SSID(i)+"\"";
-      json += ",\"bssid\":\""+WiFi.BSSIDstr(i)+"\"";
-      json += ",\"channel\":"+String(WiFi.channel(i));
-      json += ",\"secure\":"+String(WiFi.encryptionType(i));
-      json += ",\"hidden\":"+String(WiFi.isHidden(i)?"true":"false");
-      json += "}";
+      json.begin_object();
+      json.member("rssi", WiFi.RSSI(i));
+      json.member("ssid", WiFi.SSID(i));
+      json.member("bssid", WiFi.BSSIDstr(i));
+      json.member("channel", WiFi.channel(i));
+      json.member("secure", WiFi.encryptionType(i));
+      json.member("hidden", WiFi.isHidden(i));
+      json.end_object();
     }
     WiFi.scanDelete();
     if(WiFi.scanComplete() == -2){
       WiFi.scanNetworks(true);
     }
   }
-  json += "]";
-  request->send(200, "text/json", json);
+  json.end_array();
+
+  response->setCode(200);
+  requestSend(request, response);
 }
 
 // -------------------------------------------------------------------
@@ -139,7 +370,7 @@ handleSaveNetwork(AsyncWebServerRequest *request) {
   String qpass = request->arg("pass");
 
   if (qsid != 0) {
-    config_save_wifi(qsid, qpass);
+    config_save_wifi(qsid.c_str(), qpass.c_str());
 
     response->setCode(200);
     response->print("saved");
@@ -163,17 +394,18 @@ handleSaveEmoncms(AsyncWebServerRequest *request) {
     return;
   }
 
-  config_save_emoncms(request->arg("server"),
-                      request->arg("node"),
-                      request->arg("apikey"),
-                      request->arg("fingerprint"));
+  config_save_emoncms(request->arg("server").c_str(),
+                      request->arg("node").c_str(),
+                      request->arg("apikey").c_str(),
+                      request->arg("fingerprint").c_str());
+  emoncms_restart();
 
   char tmpStr[200];
   snprintf(tmpStr, sizeof(tmpStr), "Saved: %s %s %s %s",
-           emoncms_server.c_str(),
-           emoncms_node.c_str(),
-           emoncms_apikey.c_str(),
-           emoncms_fingerprint.c_str());
+           config_emoncms_server(),
+           config_emoncms_node(),
+           config_emoncms_apikey(),
+           config_emoncms_fingerprint());
   DBUGLN(tmpStr);
 
   response->setCode(200);
@@ -192,14 +424,14 @@ handleSaveMqtt(AsyncWebServerRequest *request) {
     return;
   }
 
-  config_save_mqtt(request->arg("server"),
-                   request->arg("topic"),
-                   request->arg("user"),
-                   request->arg("pass"));
+  config_save_mqtt(request->arg("server").c_str(),
+                   request->arg("topic").c_str(),
+                   request->arg("user").c_str(),
+                   request->arg("pass").c_str());
 
   char tmpStr[200];
-  snprintf(tmpStr, sizeof(tmpStr), "Saved: %s %s %s %s", mqtt_server.c_str(),
-          mqtt_topic.c_str(), mqtt_user.c_str(), mqtt_pass.c_str());
+  snprintf(tmpStr, sizeof(tmpStr), "Saved: %s %s %s %s", config_mqtt_server(),
+          config_mqtt_topic(), config_mqtt_user(), config_mqtt_pass());
   DBUGLN(tmpStr);
 
   response->setCode(200);
@@ -223,7 +455,8 @@ handleSaveAdmin(AsyncWebServerRequest *request) {
   String quser = request->arg("user");
   String qpass = request->arg("pass");
 
-  config_save_admin(quser, qpass);
+  config_save_admin(quser.c_str(), qpass.c_str());
+  events_authentication(config_www_username(), config_www_password());
 
   response->setCode(200);
   response->print("saved");
@@ -243,7 +476,7 @@ handleSaveOhmkey(AsyncWebServerRequest *request) {
 
   String qohm = request->arg("ohm");
 
-  config_save_ohm(qohm);
+  config_save_ohm(qohm.c_str());
 
   response->setCode(200);
   response->print("saved");
@@ -261,144 +494,540 @@ handleStatus(AsyncWebServerRequest *request) {
     return;
   }
 
-  String s = "{";
+  JsonWriter json(*response);
+  json.begin_object();
   if (wifi_mode == WIFI_MODE_STA) {
-    s += "\"mode\":\"STA\",";
+    json.member("mode", "STA");
   } else if (wifi_mode == WIFI_MODE_AP_STA_RETRY
              || wifi_mode == WIFI_MODE_AP_ONLY) {
-    s += "\"mode\":\"AP\",";
+    json.member("mode", "AP");
   } else if (wifi_mode == WIFI_MODE_AP_AND_STA) {
-    s += "\"mode\":\"STA+AP\",";
+    json.member("mode", "STA+AP");
+  }
+  json.key("networks");
+  json.begin_array();
+  for (int i = 0; i < wifi_network_count; i++) {
+    json.value(wifi_network_ssid[i]);
+  }
+  json.end_array();
+  json.key("rssi");
+  json.begin_array();
+  for (int i = 0; i < wifi_network_count; i++) {
+    json.quoted(wifi_network_rssi[i]);
+  }
+  json.end_array();
+
+  json.member_quoted("srssi", WiFi.RSSI());
+  json.member("ipaddress", ipaddress);
+  json.member_quoted("emoncms_connected", emoncms_connected);
+  json.member_quoted("packets_sent", packets_sent);
+  json.member_quoted("packets_success", packets_success);
+
+  json.member_quoted("mqtt_connected", mqtt_connected());
+
+  // RAPI link, these move with every command so are kept out of the
+  // cached /rapiupdate
+  json.member_quoted("comm_sent", comm_sent);
+  json.member_quoted("comm_success", comm_success);
+  json.member_quoted("comm_corrupt", comm_corrupt);
+  json.member_quoted("comm_unmatched", comm_unmatched);
+  json.member_quoted("comm_timeout", comm_timeout);
+  json.member_quoted("comm_cache_hit", comm_cache_hit);
+  json.member_quoted("comm_cache_join", comm_cache_join);
+  json.member_quoted("comm_cache_miss", comm_cache_miss);
+
+  json.member("ohm_hour", ohm_hour);
+
+  // Effective RAPI poll intervals (ms), 0 is read on demand only
+  json.member("rapi_poll_active", rapi_poll_active());
+  json.key("rapi_poll");
+  json.begin_object();
+  for (int i = 0; i < rapi_poll_count(); i++) {
+    char cmd[4];
+    strlcpy(cmd, rapi_poll_command(i), sizeof(cmd));
+    json.member(cmd, rapi_poll_interval(i));
   }
-  s += "\"networks\":[" + st + "],";
-  s += "\"rssi\":[" + rssi + "],";
+  json.end_object();
 
-  s += "\"srssi\":\"" + String(WiFi.RSSI()) + "\",";
-  s += "\"ipaddress\":\"" + ipaddress + "\",";
-  s += "\"emoncms_connected\":\"" + String(emoncms_connected) + "\",";
-  s += "\"packets_sent\":\"" + String(packets_sent) + "\",";
-  s += "\"packets_success\":\"" + String(packets_success) + "\",";
+  // Boot timing (ms since power on), 0 until it has happened
+  json.member("time_to_http", firstResponseTime);
+  json.member("time_to_populated", rapi_populated_time);
 
-  s += "\"mqtt_connected\":\"" + String(mqtt_connected()) + "\",";
+  // Most heap taken to build a reply since boot
+  json.member("http_heap_peak", replyHeapPeak);
 
-  s += "\"ohm_hour\":\"" + ohm_hour + "\",";
+  // Settings written to flash, to keep an eye on wear
+  const ConfigStoreStats &configStats = config_store_stats();
+  json.member("config_commits", configStats.commits);
+  json.member("config_commit_time", configStats.commit_time);   // us
+  json.member("config_erases", configStats.erases);
+  json.member("config_erase_estimate", configStats.erase_estimate);
 
-  s += "\"free_heap\":\"" + String(ESP.getFreeHeap()) + "\"";
+  json.member_quoted("free_heap", ESP.getFreeHeap());
 
 #ifdef ENABLE_LEGACY_API
-  s += ",\"version\":\"" + currentfirmware + "\"";
-  s += ",\"ssid\":\"" + esid + "\"";
-  //s += ",\"pass\":\""+epass+"\""; security risk: DONT RETURN PASSWORDS
-  s += ",\"emoncms_server\":\"" + emoncms_server + "\"";
-  s += ",\"emoncms_node\":\"" + emoncms_node + "\"";
-  //s += ",\"emoncms_apikey\":\""+emoncms_apikey+"\""; security risk: DONT RETURN APIKEY
-  s += ",\"emoncms_fingerprint\":\"" + emoncms_fingerprint + "\"";
-  s += ",\"mqtt_server\":\"" + mqtt_server + "\"";
-  s += ",\"mqtt_topic\":\"" + mqtt_topic + "\"";
-  s += ",\"mqtt_user\":\"" + mqtt_user + "\"";
-  //s += ",\"mqtt_pass\":\""+mqtt_pass+"\""; security risk: DONT RETURN PASSWORDS
-  s += ",\"www_username\":\"" + www_username + "\"";
-  //s += ",\"www_password\":\""+www_password+"\""; security risk: DONT RETURN PASSWORDS
-  s += ",\"ohmkey\":\"" + ohm + "\"";
+  json.member("version", currentfirmware);
+  json.member("ssid", config_esid());
+  // pass, security risk: DONT RETURN PASSWORDS
+  json.member("emoncms_server", config_emoncms_server());
+  json.member("emoncms_node", config_emoncms_node());
+  // emoncms_apikey, security risk: DONT RETURN APIKEY
+  json.member("emoncms_fingerprint", config_emoncms_fingerprint());
+  json.member("mqtt_server", config_mqtt_server());
+  json.member("mqtt_topic", config_mqtt_topic());
+  json.member("mqtt_user", config_mqtt_user());
+  // mqtt_pass, security risk: DONT RETURN PASSWORDS
+  json.member("www_username", config_www_username());
+  // www_password, security risk: DONT RETURN PASSWORDS
+  json.member("ohmkey", config_ohm_key());
 #endif
-  s += "}";
+  json.end_object();
 
   response->setCode(200);
-  response->print(s);
-  request->send(response);
+  requestSend(request, response);
 }
 
 // -------------------------------------------------------------------
 // Returns OpenEVSE Config json
 // url: /config
 // -------------------------------------------------------------------
+static void
+renderConfig(JsonWriter &json) {
+  EvseTelemetry evse;
+  input_snapshot(evse);
+
+  json.begin_object();
+  json.member("firmware", evse.firmware);
+  json.member("protocol", evse.protocol);
+  json.member_quoted("espflash", espflash);
+  json.member("version", currentfirmware);
+  json.member_quoted("diodet", (evse.flags & EVSE_FLAG_DIODE_CK) ? 1 : 0);
+  json.member_quoted("gfcit", (evse.flags & EVSE_FLAG_GFCI_TEST) ? 1 : 0);
+  json.member_quoted("groundt", (evse.flags & EVSE_FLAG_GROUND_CK) ? 1 : 0);
+  json.member_quoted("relayt", (evse.flags & EVSE_FLAG_STUCK_RELAY) ? 1 : 0);
+  json.member_quoted("ventt", (evse.flags & EVSE_FLAG_VENT_CK) ? 1 : 0);
+  json.member_quoted("tempt", (evse.flags & EVSE_FLAG_TEMP_CK) ? 1 : 0);
+  json.member_quoted("service", evse.service);
+  json.member_quoted("l1min", evse.current_l1min);
+  json.member_quoted("l1max", evse.current_l1max);
+  json.member_quoted("l2min", evse.current_l2min);
+  json.member_quoted("l2max", evse.current_l2max);
+  json.member_quoted("scale", evse.current_scale);
+  json.member_quoted("offset", evse.current_offset);
+  json.member_quoted_hex("gfcicount", evse.gfci_count);
+  json.member_quoted_hex("nogndcount", evse.nognd_count);
+  json.member_quoted_hex("stuckcount", evse.stuck_count);
+  json.member_quoted("kwhlimit", evse.kwh_limit);
+  json.member_quoted("timelimit", evse.time_limit);
+  // RAPI reads that have not been answered yet, their values are defaults
+  json.key("pending");
+  json.begin_array();
+  for (int i = 0; i < rapi_poll_count(); i++) {
+    if (!rapi_poll_valid(i)) {
+      char cmd[4];
+      strlcpy(cmd, rapi_poll_command(i), sizeof(cmd));
+      json.value(cmd);
+    }
+  }
+  json.end_array();
+  // Secrets are left out, DONT RETURN PASSWORDS
+  config_write_json(json);
+  json.end_object();
+}
+
+static ReplyCache configCache(renderConfig, 0);
+
 void
 handleConfig(AsyncWebServerRequest *request) {
+  // Both counters only go up, so their sum changes when either does.
+  // The live values are not shown, so their changes are left out.
+  requestSendCached(request, configCache, input_settings_generation() + config_generation);
+}
+
+static CachedReplyHandler configHandler("/config", handleConfig);
+
+// -------------------------------------------------------------------
+// Change any of the settings in one request
+// url: /config, POST
+//
+// The body is a JSON object of the settings to change, keyed as in
+// /config plus pass, emoncms_apikey, mqtt_pass, www_password and
+// ohmkey, e.g. {"ssid":"home","pass":"secret"}. Nothing is changed
+// unless all of it is valid. The changes are saved together before the
+// reply, and only what uses them is restarted.
+// -------------------------------------------------------------------
+#define CONFIG_MAX_BODY 2048
+
+static void
+handleConfigBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+  requestReadBody(request, data, len, index, total, CONFIG_MAX_BODY);
+}
+
+void
+handleConfigPost(AsyncWebServerRequest *request) {
   AsyncResponseStream *response;
   if(false == requestPreProcess(request, response)) {
     return;
   }
 
-  String s = "{";
-  s += "\"firmware\":\"" + firmware + "\",";
-  s += "\"protocol\":\"" + protocol + "\",";
-  s += "\"espflash\":\"" + String(espflash) + "\",";
-  s += "\"version\":\"" + currentfirmware + "\",";
-  s += "\"diodet\":\"" + String(diode_ck) + "\",";
-  s += "\"gfcit\":\"" + String(gfci_test) + "\",";
-  s += "\"groundt\":\"" + String(ground_ck) + "\",";
-  s += "\"relayt\":\"" + String(stuck_relay) + "\",";
-  s += "\"ventt\":\"" + String(vent_ck) + "\",";
-  s += "\"tempt\":\"" + String(temp_ck) + "\",";
-  s += "\"service\":\"" + String(service) + "\",";
-  s += "\"l1min\":\"" + current_l1min + "\",";
-  s += "\"l1max\":\"" + current_l1max + "\",";
-  s += "\"l2min\":\"" + current_l2min + "\",";
-  s += "\"l2max\":\"" + current_l2max + "\",";
-  s += "\"scale\":\"" + current_scale + "\",";
-  s += "\"offset\":\"" + current_offset + "\",";
-  s += "\"gfcicount\":\"" + gfci_count + "\",";
-  s += "\"nogndcount\":\"" + nognd_count + "\",";
-  s += "\"stuckcount\":\"" + stuck_count + "\",";
-  s += "\"kwhlimit\":\"" + kwh_limit + "\",";
-  s += "\"timelimit\":\"" + time_limit + "\",";
-  s += "\"ssid\":\"" + esid + "\",";
-  //s += "\"pass\":\""+epass+"\","; security risk: DONT RETURN PASSWORDS
-  s += "\"emoncms_server\":\"" + emoncms_server + "\",";
-  s += "\"emoncms_node\":\"" + emoncms_node + "\",";
-  // s += "\"emoncms_apikey\":\""+emoncms_apikey+"\","; security risk: DONT RETURN APIKEY
-  s += "\"emoncms_fingerprint\":\"" + emoncms_fingerprint + "\",";
-  s += "\"mqtt_server\":\"" + mqtt_server + "\",";
-  s += "\"mqtt_topic\":\"" + mqtt_topic + "\",";
-  s += "\"mqtt_user\":\"" + mqtt_user + "\",";
-  //s += "\"mqtt_pass\":\""+mqtt_pass+"\","; security risk: DONT RETURN PASSWORDS
-  s += "\"www_username\":\"" + www_username + "\"";
-  //s += "\"www_password\":\""+www_password+"\","; security risk: DONT RETURN PASSWORDS
-  s += "}";
-  s.replace(" ", "");
+  if(false == requestExpectJson(request, response)) {
+    return;
+  }
+
+  const char *body = (const char *)request->_tempObject;
+  uint32_t changed;
+  if(NULL == body || false == config_set_json(body, strlen(body), changed)) {
+    delete response;
+    request->send(400, "text/plain", "Expected a JSON object of known settings");
+    return;
+  }
+
+  // Written now rather than from config_loop(), so a reply means saved
+  bool saved = config_commit();
+
+  uint8_t flags = config_flags(changed);
+  if(flags & CONFIG_WIFI) {
+    wifiRestartTime = millis() + 2000;
+  }
+  if(flags & CONFIG_EMONCMS) {
+    emoncms_restart();
+  }
+  if(flags & CONFIG_MQTT) {
+    mqttRestartTime = millis();
+  }
+  if(flags & CONFIG_WWW) {
+    events_authentication(config_www_username(), config_www_password());
+  }
+
+  if(false == saved) {
+    // In use now, config_loop() keeps trying to write them
+    delete response;
+    request->send(500, "text/plain", "Settings changed but could not be saved");
+    return;
+  }
+
+  JsonWriter json(*response);
+  json.begin_object();
+  json.member("generation", config_generation);
+  json.key("changed");
+  json.begin_array();
+  for(int f = 0; f < CONFIG_FIELDS; f++) {
+    if(changed & (1UL << f)) {
+      json.value(config_key(f));
+    }
+  }
+  json.end_array();
+  json.end_object();
 
   response->setCode(200);
-  response->print(s);
-  request->send(response);
+  requestSend(request, response);
 }
 
- // -------------------------------------------------------------------
-// Returns Updates JSON
-// url: /rapiupdate
+// -------------------------------------------------------------------
+// Writes a reply a piece at a time as the connection takes it, so its
+// size does not depend on the free heap. next() formats the next piece
+// into buf.
+// -------------------------------------------------------------------
+class ChunkedWriter {
+  public:
+    ChunkedWriter() : len(0), pos(0), done(false) {
+    }
+    virtual ~ChunkedWriter() {
+    }
+
+    size_t operator()(uint8_t *out, size_t max, size_t index) {
+      size_t written = 0;
+      while (written < max) {
+        if (pos == len) {
+          pos = len = 0;
+          if (done || false == next()) {
+            done = true;
+            break;
+          }
+        }
+        size_t count = min(max - written, (size_t)(len - pos));
+        memcpy(out + written, buf + pos, count);
+        pos += count;
+        written += count;
+      }
+      return written;
+    }
+
+  protected:
+    char buf[256];
+    int len;
+    virtual bool next() = 0;
+
+  private:
+    int pos;
+    bool done;
+};
+
+class HistoryWriter : public ChunkedWriter {
+  public:
+    HistoryWriter(int field, unsigned long sample, unsigned long end, unsigned long bucket) :
+      field(field), sample(sample), end(end), bucket(bucket), first(true), footer(false)
+    {
+      len = snprintf(buf, sizeof(buf), "{\"interval\":%lu,\"now\":%lu,\"start\":%lu,\"data\":[",
+                     bucket * HISTORY_INTERVAL, millis(), history_time(sample));
+    }
+
+  private:
+    int field;
+    unsigned long sample;     // Next sample to write
+    unsigned long end;
+    unsigned long bucket;     // Samples per entry
+    bool first;
+    bool footer;
+
+    bool next() {
+      if (sample >= end) {
+        if (footer) {
+          return false;
+        }
+        len = snprintf(buf, sizeof(buf), "]}");
+        footer = true;
+        return true;
+      }
+
+      const char *sep = first ? "" : ",";
+      first = false;
+      long min_value = 0, max_value = 0, sum = 0;
+      int count = 0;
+      for (unsigned long last = sample + bucket; sample < last && sample < end; sample++) {
+        long value;
+        if (history_value(field, sample, value)) {
+          min_value = 0 == count || value < min_value ? value : min_value;
+          max_value = 0 == count || value > max_value ? value : max_value;
+          sum += value;
+          count++;
+        }
+      }
+
+      // Samples overwritten while the reply was sent are null
+      if (0 == count) {
+        len = snprintf(buf, sizeof(buf), "%snull", sep);
+      } else if (1 == bucket) {
+        len = snprintf(buf, sizeof(buf), "%s%ld", sep, sum);
+      } else {
+        len = snprintf(buf, sizeof(buf), "%s[%ld,%ld,%ld]", sep, min_value, max_value, sum / count);
+      }
+      return true;
+    }
+};
+
+// -------------------------------------------------------------------
+// Returns the history of one field
+// url: /history?field=amp[&since=<ms>][&bucket=<s>]
+//
+// since is in ms since boot, as now in the reply. With bucket each
+// entry is [min,max,avg] over that many seconds of samples.
 // -------------------------------------------------------------------
 void
-handleUpdate(AsyncWebServerRequest *request) {
+handleHistory(AsyncWebServerRequest *request) {
+  if(config_www_username()[0] && !request->authenticate(config_www_username(), config_www_password())) {
+    return request->requestAuthentication();
+  }
 
-  AsyncResponseStream *response;
-  if(false == requestPreProcess(request, response)) {
+  int field = history_field(request->arg("field").c_str());
+  if(field < 0) {
+    request->send(400, "text/plain", "Unknown field, expected amp, pilot, temp1, temp2, temp3 or state");
     return;
   }
 
-  String s = "{";
-  s += "\"comm_sent\":\"" + String(comm_sent) + "\",";
-  s += "\"comm_success\":\"" + String(comm_success) + "\",";
+  unsigned long first = history_first();
+  unsigned long end = history_next();
+  if(request->hasArg("since")) {
+    first = max(first, history_sample_at(request->arg("since").toInt()));
+  }
+  unsigned long bucket = 1;
+  if(request->hasArg("bucket")) {
+    bucket = max(1L, request->arg("bucket").toInt() * 1000L / HISTORY_INTERVAL);
+  }
+  first = min(first, end);
+
+  AsyncWebServerResponse *response =
+    request->beginChunkedResponse("application/json", HistoryWriter(field, first, end, bucket));
+  if(enableCors) {
+    response->addHeader("Access-Control-Allow-Origin", "*");
+  }
+  request->send(response);
+}
+
+// -------------------------------------------------------------------
+// Returns the telemetry log from SPIFFS, oldest first
+// url: /log[?format=json]
+//
+// CSV by default. time is Unix time, empty (null) if the OpenEVSE has
+// no clock; boot and uptime (s) place the record regardless.
+// -------------------------------------------------------------------
+class DatalogWriter : public ChunkedWriter {
+  public:
+    DatalogWriter(bool json) : json(json), first(true), footer(false) {
+      int n = snprintf(buf, sizeof(buf), json ? "{\"fields\":[\"time\",\"boot\",\"uptime\"" : "time,boot,uptime");
+      for (int i = 0; i < DATALOG_FIELDS; i++) {
+        n += snprintf(buf + n, sizeof(buf) - n, json ? ",\"%s\"" : ",%s", datalog_field_name(i));
+      }
+      n += snprintf(buf + n, sizeof(buf) - n, json ? "],\"data\":[" : "\n");
+      len = n;
+    }
+
+  private:
+    DatalogReader reader;
+    bool json;
+    bool first;
+    bool footer;
+
+    bool next() {
+      DatalogRecord record;
+      if (false == reader.next(record)) {
+        if (footer || false == json) {
+          return false;
+        }
+        len = snprintf(buf, sizeof(buf), "]}");
+        footer = true;
+        return true;
+      }
+
+      int n = 0;
+      if (json) {
+        n += snprintf(buf, sizeof(buf), first ? "[" : ",[");
+      }
+      first = false;
+      if (record.time) {
+        n += snprintf(buf + n, sizeof(buf) - n, "%u", record.time);
+      } else if (json) {
+        n += snprintf(buf + n, sizeof(buf) - n, "null");
+      }
+      n += snprintf(buf + n, sizeof(buf) - n, ",%u,%u", record.boot, record.uptime);
+      for (int i = 0; i < DATALOG_FIELDS; i++) {
+        n += snprintf(buf + n, sizeof(buf) - n, ",%ld", record.values[i]);
+      }
+      n += snprintf(buf + n, sizeof(buf) - n, json ? "]" : "\n");
+      len = n;
+      return true;
+    }
+};
+
+void
+handleLog(AsyncWebServerRequest *request) {
+  if(config_www_username()[0] && !request->authenticate(config_www_username(), config_www_password())) {
+    return request->requestAuthentication();
+  }
+
+  // Include the records still held in RAM
+  datalog_flush();
+
+  bool json = request->arg("format") == "json";
+  AsyncWebServerResponse *response =
+    request->beginChunkedResponse(json ? "application/json" : "text/csv", DatalogWriter(json));
+  if(enableCors) {
+    response->addHeader("Access-Control-Allow-Origin", "*");
+  }
+  request->send(response);
+}
+
+// -------------------------------------------------------------------
+// Returns the charging sessions, newest first
+// url: /sessions
+//
+// The session in progress, if any, comes first with active set
+// -------------------------------------------------------------------
+class SessionsWriter : public ChunkedWriter {
+  public:
+    SessionsWriter() : id(session_last_id()), active(true), first(true), footer(false) {
+      len = snprintf(buf, sizeof(buf), "[");
+    }
+
+  private:
+    uint32_t id;              // Next completed session to write
+    bool active;
+    bool first;
+    bool footer;
+
+    bool next() {
+      SessionRecord record;
+      bool found = false;
+      bool current = false;
+      if (active) {
+        active = false;
+        found = current = session_current(record);
+      }
+      while (!found && id > 0) {
+        found = session_read(id--, record);
+        if (!found) {
+          id = 0;
+        }
+      }
+
+      if (!found) {
+        if (footer) {
+          return false;
+        }
+        len = snprintf(buf, sizeof(buf), "]");
+        footer = true;
+        return true;
+      }
+
+      len = first ? 0 : snprintf(buf, sizeof(buf), ",");
+      first = false;
+      len += session_format(record, current, buf + len, sizeof(buf) - len);
+      return true;
+    }
+};
+
+void
+handleSessions(AsyncWebServerRequest *request) {
+  if(config_www_username()[0] && !request->authenticate(config_www_username(), config_www_password())) {
+    return request->requestAuthentication();
+  }
+
+  AsyncWebServerResponse *response =
+    request->beginChunkedResponse("application/json", SessionsWriter());
+  if(enableCors) {
+    response->addHeader("Access-Control-Allow-Origin", "*");
+  }
+  request->send(response);
+}
+
+ // -------------------------------------------------------------------
+// Returns Updates JSON
+// url: /rapiupdate
+// -------------------------------------------------------------------
+static void
+renderUpdate(JsonWriter &json) {
+  EvseTelemetry evse;
+  input_snapshot(evse);
+
+  json.begin_object();
 #ifdef ENABLE_LEGACY_API
-  s += "\"ohmhour\":\"" + ohm_hour + "\",";
-  s += "\"espfree\":\"" + String(espfree) + "\",";
-  s += "\"packets_sent\":\"" + String(packets_sent) + "\",";
-  s += "\"packets_success\":\"" + String(packets_success) + "\",";
+  json.member("ohmhour", ohm_hour);
+  json.member_quoted("espfree", espfree);
+  json.member_quoted("packets_sent", packets_sent);
+  json.member_quoted("packets_success", packets_success);
 #endif
-  s += "\"amp\":\"" + String(amp) + "\",";
-  s += "\"pilot\":\"" + String(pilot) + "\",";
-  s += "\"temp1\":\"" + String(temp1) + "\",";
-  s += "\"temp2\":\"" + String(temp2) + "\",";
-  s += "\"temp3\":\"" + String(temp3) + "\",";
-  s += "\"estate\":\"" + String(estate) + "\",";
-  s += "\"wattsec\":\"" + wattsec + "\",";
-  s += "\"watthour\":\"" + watthour_total + "\"";
-  s += "}";
-  s.replace(" ", "");
+  json.member_quoted("amp", evse.amp);
+  json.member_quoted("pilot", evse.pilot);
+  json.member_quoted("temp1", evse.temp1);
+  json.member_quoted("temp2", evse.temp2);
+  json.member_quoted("temp3", evse.temp3);
+  json.member("estate", input_state_name(evse.state));
+  json.member_quoted("wattsec", evse.wattsec);
+  json.member_quoted("watthour", evse.watthour_total);
+  json.end_object();
+}
 
-  response->setCode(200);
-  response->print(s);
-  request->send(response);
+// Only rendered again when the telemetry changes, so the ETag holds
+// while it does not
+static ReplyCache updateCache(renderUpdate, 0);
+
+void
+handleUpdate(AsyncWebServerRequest *request) {
+  requestSendCached(request, updateCache, input_generation());
 }
 
+static CachedReplyHandler updateHandler("/rapiupdate", handleUpdate);
+
 // -------------------------------------------------------------------
 // Reset config and reboot
 // url: /reset
@@ -538,6 +1167,42 @@ handleUpdateUpload(AsyncWebServerRequest *request, String filename, size_t index
   }
 }
 
+// -------------------------------------------------------------------
+// RAPI passthrough
+// url: /r
+//
+// The response is sent from rapi_loop() once the OpenEVSE replies
+// -------------------------------------------------------------------
+struct RapiWebRequest {
+  AsyncWebServerRequest *request;
+  AsyncResponseStream *response;
+  bool json;
+  String cmd;
+};
+
+void
+handleRapiReply(int result, const RapiTokens &reply, void *ctx) {
+  RapiWebRequest *web = (RapiWebRequest *)ctx;
+  AsyncResponseStream *response = web->response;
+
+  if(web->json) {
+    JsonWriter json(*response);
+    json.begin_object();
+    json.member("cmd", web->cmd);
+    json.member("ret", reply.line);
+    json.end_object();
+  } else {
+    response->print(web->cmd);
+    response->print("<p>&gt;");
+    response->print(reply.line);
+    response->print("<p></html>\r\n\r\n");
+  }
+
+  response->setCode(200);
+  web->response = NULL;
+  web->request->send(response);
+}
+
 void
 handleRapi(AsyncWebServerRequest *request) {
   bool json = request->hasArg("json");
@@ -547,48 +1212,239 @@ handleRapi(AsyncWebServerRequest *request) {
     return;
   }
 
-  String s;
-
   if(false == json) {
-    s = "<html><font size='20'><font color=006666>Open</font><b>EVSE</b></font><p>";
-    s += "<b>Open Source Hardware</b><p>RAPI Command Sent<p>Common Commands:<p>";
-    s += "Set Current - $SC XX<p>Set Service Level - $SL 1 - $SL 2 - $SL A<p>";
-    s += "Get Real-time Current - $GG<p>Get Temperatures - $GP<p>";
-    s += "<p>";
-    s += "<form method='get' action='r'><label><b><i>RAPI Command:</b></i></label>";
-    s += "<input name='rapi' length=32><p><input type='submit'></form>";
+    response->print(
+      "<html><font size='20'><font color=006666>Open</font><b>EVSE</b></font><p>"
+      "<b>Open Source Hardware</b><p>RAPI Command Sent<p>Common Commands:<p>"
+      "Set Current - $SC XX<p>Set Service Level - $SL 1 - $SL 2 - $SL A<p>"
+      "Get Real-time Current - $GG<p>Get Temperatures - $GP<p>"
+      "<p>"
+      "<form method='get' action='r'><label><b><i>RAPI Command:</b></i></label>"
+      "<input name='rapi' length=32><p><input type='submit'></form>");
   }
 
   if(request->hasArg("rapi"))
   {
-    String rapiString;
-    String rapi = request->arg("rapi");
-
-    // BUG: Really we should do this in the main loop not here...
-    Serial.flush();
-    Serial.println(rapi);
-    delay(commDelay);
-    while (Serial.available()) {
-      rapiString = Serial.readStringUntil('\r');
-    }
-
-    if(json) {
-      s = "{\"cmd\":\""+rapi+"\",\"ret\":\""+rapiString+"\"}";
-    } else {
-      s += rapi;
-      s += "<p>&gt;";
-      s += rapiString;
+    RapiWebRequest *web = new RapiWebRequest();
+    web->request = request;
+    web->response = response;
+    web->json = json;
+    web->cmd = request->arg("rapi");
+
+    // Called once the client has gone, whether or not we replied
+    request->onDisconnect([web]() {
+      rapi_cancel(web);
+      delete web->response;
+      delete web;
+    });
+
+    if(false == rapi_send(web->cmd.c_str(), RAPI_PRIORITY_HIGH, handleRapiReply, web)) {
+      web->response = NULL;
+      delete response;
+      request->send(503, "text/plain", "RAPI queue full");
     }
+    return;
   }
+
   if(false == json) {
-    s += "<p></html>\r\n\r\n";
+    response->print("<p></html>\r\n\r\n");
   }
 
   response->setCode(200);
-  response->print(s);
   request->send(response);
 }
 
+// -------------------------------------------------------------------
+// RAPI batch
+// url: /rapi/batch
+//
+// POST a JSON array of RAPI commands, e.g. ["$SC 13","$SL 2"]. The
+// commands are pipelined to the OpenEVSE in order and the reply is an
+// array of {cmd, ret, ok, latency_us}, latency being from queueing to
+// the reply. With abort=1 the commands are sent one at a time and no
+// more are sent after the first $NK or timeout, the result stops at
+// that command.
+// -------------------------------------------------------------------
+#define RAPI_BATCH_MAX_COMMANDS 16
+#define RAPI_BATCH_MAX_BODY     1024
+
+struct RapiBatch;
+
+struct RapiBatchCommand {
+  RapiBatch *batch;
+  bool complete;
+  int result;
+  unsigned long start;        // micros() when queued
+  unsigned long latency;
+  char cmd[RAPI_MAX_COMMAND];
+  char ret[RAPI_MAX_REPLY];
+};
+
+struct RapiBatch {
+  AsyncWebServerRequest *request;
+  AsyncResponseStream *response;
+  bool abort;                 // Stop at the first failure
+  bool failed;
+  int count;
+  int sent;                   // Commands queued
+  int done;                   // Commands completed
+  RapiBatchCommand cmds[RAPI_BATCH_MAX_COMMANDS];
+};
+
+static void rapiBatchQueue(RapiBatch *batch);
+
+static void
+rapiBatchComplete(RapiBatchCommand *cmd, int result, const char *ret) {
+  RapiBatch *batch = cmd->batch;
+
+  cmd->complete = true;
+  cmd->result = result;
+  cmd->latency = micros() - cmd->start;
+  strncpy(cmd->ret, ret, sizeof(cmd->ret) - 1);
+  cmd->ret[sizeof(cmd->ret) - 1] = '\0';
+
+  batch->done++;
+  if(RAPI_RESULT_OK != result) {
+    batch->failed = true;
+  }
+}
+
+static void
+rapiBatchSendResponse(RapiBatch *batch) {
+  AsyncResponseStream *response = batch->response;
+
+  JsonWriter json(*response);
+  json.begin_array();
+  // Retries after a timeout can complete commands out of order
+  for(int i = 0; i < batch->sent; i++) {
+    RapiBatchCommand &cmd = batch->cmds[i];
+    if(false == cmd.complete) {
+      continue;
+    }
+    json.begin_object();
+    json.member("cmd", cmd.cmd);
+    json.member("ret", cmd.ret);
+    json.member("ok", RAPI_RESULT_OK == cmd.result);
+    json.member("latency_us", cmd.latency);
+    json.end_object();
+  }
+  json.end_array();
+
+  response->setCode(200);
+  batch->response = NULL;
+  batch->request->send(response);
+}
+
+static void
+handleRapiBatchReply(int result, const RapiTokens &reply, void *ctx) {
+  RapiBatchCommand *cmd = (RapiBatchCommand *)ctx;
+  RapiBatch *batch = cmd->batch;
+
+  rapiBatchComplete(cmd, result, RAPI_RESULT_TIMEOUT == result ? "" : reply.line);
+  rapiBatchQueue(batch);
+}
+
+// Keep up to RAPI_MAX_IN_FLIGHT of the batch with the transport, the
+// transport itself limits what is on the wire. With abort set only one
+// is, as a command already queued would still reach the OpenEVSE after
+// one before it failed.
+static void
+rapiBatchQueue(RapiBatch *batch) {
+  int max_in_flight = batch->abort ? 1 : RAPI_MAX_IN_FLIGHT;
+  while(batch->sent < batch->count &&
+        batch->sent - batch->done < max_in_flight &&
+        !(batch->abort && batch->failed))
+  {
+    RapiBatchCommand *cmd = &batch->cmds[batch->sent++];
+    cmd->start = micros();
+    if(false == rapi_send(cmd->cmd, RAPI_PRIORITY_HIGH, handleRapiBatchReply, cmd)) {
+      rapiBatchComplete(cmd, RAPI_RESULT_TIMEOUT, "");
+    }
+  }
+
+  if(batch->done == batch->sent &&
+     (batch->sent == batch->count || (batch->abort && batch->failed)))
+  {
+    rapiBatchSendResponse(batch);
+  }
+}
+
+static void
+handleRapiBatchBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+  requestReadBody(request, data, len, index, total, RAPI_BATCH_MAX_BODY);
+}
+
+void
+handleRapiBatch(AsyncWebServerRequest *request) {
+  AsyncResponseStream *response;
+  if(false == requestPreProcess(request, response, "application/json")) {
+    return;
+  }
+
+  if(false == requestExpectJson(request, response)) {
+    return;
+  }
+
+  const char *body = (const char *)request->_tempObject;
+  if(NULL == body) {
+    delete response;
+    request->send(400, "text/plain", "Expected a JSON array of up to 1024 bytes");
+    return;
+  }
+
+  RapiBatch *batch = new RapiBatch();
+  batch->request = request;
+  batch->response = response;
+  batch->abort = request->hasArg("abort") && request->arg("abort") != "0";
+  batch->failed = false;
+  batch->count = 0;
+  batch->sent = 0;
+  batch->done = 0;
+
+  JsonReader reader;
+  json_reader_init(reader, body, strlen(body));
+  bool valid = json_expect(reader, '[');
+  if(valid && false == json_expect(reader, ']')) {
+    do {
+      if(batch->count >= RAPI_BATCH_MAX_COMMANDS) {
+        valid = false;
+        break;
+      }
+      RapiBatchCommand &cmd = batch->cmds[batch->count];
+      if(json_read_string(reader, cmd.cmd, sizeof(cmd.cmd) - RAPI_SUFFIX_LEN) <= 0) {
+        valid = false;
+        break;
+      }
+      cmd.batch = batch;
+      cmd.complete = false;
+      cmd.ret[0] = '\0';
+      batch->count++;
+    } while(json_expect(reader, ','));
+    valid = valid && json_expect(reader, ']');
+  }
+  valid = valid && json_at_end(reader);
+
+  if(false == valid) {
+    delete batch;
+    delete response;
+    request->send(400, "text/plain", "Expected a JSON array of up to 16 RAPI commands");
+    return;
+  }
+
+  // Called once the client has gone, whether or not we replied
+  request->onDisconnect([batch]() {
+    for(int i = 0; i < batch->sent; i++) {
+      if(false == batch->cmds[i].complete) {
+        rapi_cancel(&batch->cmds[i]);
+      }
+    }
+    delete batch->response;
+    delete batch;
+  });
+
+  rapiBatchQueue(batch);
+}
+
 void handleNotFound(AsyncWebServerRequest *request)
 {
   DBUG("NOT_FOUND: ");
@@ -642,11 +1498,6 @@ void
 web_server_setup() {
   SPIFFS.begin(); // mount the fs
 
-  // Setup the static files
-  server.serveStatic("/", SPIFFS, "/")
-    .setDefaultFile("index.html")
-    .setAuthentication(www_username.c_str(), www_password.c_str());
-
   // Start server & server root html /
   server.on("/",handleHome);
 
@@ -654,9 +1505,19 @@ web_server_setup() {
   server.on("/generate_204", handleHome);  //Android captive portal. Maybe not needed. Might be handled by notFound
   server.on("/fwlink", handleHome);  //Microsoft captive portal. Maybe not needed. Might be handled by notFound
   server.on("/status", handleStatus);
-  server.on("/rapiupdate", handleUpdate);
+  server.addHandler(&updateHandler);
+  server.on("/history", handleHistory);
+  server.on("/log", handleLog);
+  server.on("/sessions", handleSessions);
+  // Before /config, which takes any method
+  server.on("/config", HTTP_POST, handleConfigPost, NULL, handleConfigBody);
+  server.addHandler(&configHandler);
   server.on("/config", handleConfig);
 
+  // Live telemetry, /ws
+  events_setup(server);
+  events_authentication(config_www_username(), config_www_password());
+
   server.on("/savenetwork", handleSaveNetwork);
   server.on("/saveemoncms", handleSaveEmoncms);
   server.on("/savemqtt", handleSaveMqtt);
@@ -666,6 +1527,8 @@ web_server_setup() {
   server.on("/reset", handleRst);
   server.on("/restart", handleRestart);
 
+  // Before /rapi, which also matches /rapi/...
+  server.on("/rapi/batch", HTTP_POST, handleRapiBatch, NULL, handleRapiBatchBody);
   server.on("/rapi", handleRapi);
   server.on("/r", handleRapi);
 
@@ -684,6 +1547,9 @@ web_server_setup() {
 //    if(requestPreProcess()) handleUpdate();
 //  });
 
+  // The web UI files, anything not matched above
+  assets_setup(server);
+
   server.onNotFound(handleNotFound);
   server.begin();
 
@@ -692,6 +1558,8 @@ web_server_setup() {
 
 void
 web_server_loop() {
+  events_loop();
+
   // Do we need to restart the WiFi?
   if(wifiRestartTime > 0 && millis() > wifiRestartTime) {
     wifiRestartTime = 0;
@@ -707,6 +1575,7 @@ web_server_loop() {
   // Do we need to restart the system?
   if(systemRestartTime > 0 && millis() > systemRestartTime) {
     systemRestartTime = 0;
+    config_commit();
     wifi_disconnect();
     ESP.restart();
   }
@@ -714,6 +1583,7 @@ web_server_loop() {
   // Do we need to reboot the system?
   if(systemRebootTime > 0 && millis() > systemRebootTime) {
     systemRebootTime = 0;
+    config_commit();
     wifi_disconnect();
     ESP.reset();
   }
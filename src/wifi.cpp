@@ -1,6 +1,7 @@
 #include "emonesp.h"
 #include "wifi.h"
 #include "config.h"
+#include "rapi.h"
 
 #include <ESP8266WiFi.h>        // Connect to Wifi
 #include <ESP8266mDNS.h>        // Resolve URL for update server etc.
@@ -24,7 +25,20 @@ String status_string = "";
 String ipaddress = "";
 
 unsigned long Timer;
-String st, rssi;
+int wifi_network_count = 0;
+char wifi_network_ssid[WIFI_MAX_NETWORKS][33];
+int8_t wifi_network_rssi[WIFI_MAX_NETWORKS];
+
+// Client connection in progress, see wifi_loop()
+#define WIFI_CLIENT_RETRY_TIME  10000   // ms to wait for each connection attempt
+#define WIFI_CLIENT_ATTEMPTS    5       // attempts before falling back to AP mode
+bool client_connecting = false;
+unsigned long client_attempt_time = 0;
+int client_attempt = 0;
+
+// Time to show the AP SSID/password on the LCD before the IP address
+#define WIFI_AP_LCD_TIME        5000
+unsigned long apLcdTime = 0;
 
 #ifdef WIFI_LED
 #ifndef WIFI_LED_ON_STATE
@@ -47,6 +61,20 @@ unsigned long wifiLedTimeOut = millis();
 int wifi_mode = WIFI_MODE_STA;
 
 
+// -------------------------------------------------------------------
+// Keep the scan results for /status
+// -------------------------------------------------------------------
+static void
+wifi_save_scan(int n) {
+  wifi_network_count = 0;
+  for (int i = 0; i < n && wifi_network_count < WIFI_MAX_NETWORKS; ++i) {
+    strlcpy(wifi_network_ssid[wifi_network_count], WiFi.SSID(i).c_str(),
+            sizeof(wifi_network_ssid[0]));
+    wifi_network_rssi[wifi_network_count] = WiFi.RSSI(i);
+    wifi_network_count++;
+  }
+}
+
 // -------------------------------------------------------------------
 // Start Access Point
 // Access point is used for wifi network selection
@@ -61,16 +89,7 @@ startAP() {
   int n = WiFi.scanNetworks();
   DEBUG.print(n);
   DEBUG.println(" networks found");
-  st = "";
-  rssi = "";
-  for (int i = 0; i < n; ++i) {
-    st += "\"" + WiFi.SSID(i) + "\"";
-    rssi += "\"" + String(WiFi.RSSI(i)) + "\"";
-    if (i < n - 1)
-      st += ",";
-    if (i < n - 1)
-      rssi += ",";
-  }
+  wifi_save_scan(n);
   delay(100);
 
   WiFi.softAPConfig(apIP, apIP, netMsk);
@@ -85,90 +104,114 @@ startAP() {
 
   IPAddress myIP = WiFi.softAPIP();
   char tmpStr[40];
-  Serial.println("$FP 0 0 SSID...OpenEVSE.");
-  delay(100);
-  Serial.println("$FP 0 1 PASS...openevse.");
-  delay(5000);
-  Serial.println("$FP 0 0 IP_Address......");
-  delay(100);
-  Serial.println("$FP 0 1 ................");
-  delay(100);
+  rapi_send("$FP 0 0 SSID...OpenEVSE.", RAPI_PRIORITY_HIGH);
+  rapi_send("$FP 0 1 PASS...openevse.", RAPI_PRIORITY_HIGH);
+  // The IP address is shown from wifi_loop() once the SSID has been up a while
+  apLcdTime = millis() + WIFI_AP_LCD_TIME;
   sprintf(tmpStr, "%d.%d.%d.%d", myIP[0], myIP[1], myIP[2], myIP[3]);
   DEBUG.print("AP IP Address: ");
   DEBUG.println(tmpStr);
-  Serial.print("$FP 0 1 ");
-  Serial.println(tmpStr);
   ipaddress = tmpStr;
 }
 
+// -------------------------------------------------------------------
+// Show the IP address on the OpenEVSE LCD
+// -------------------------------------------------------------------
+void
+lcdShowIp(const char *title) {
+  char tmpStr[40];
+  rapi_send(title, RAPI_PRIORITY_HIGH);
+  rapi_send("$FP 0 1 ................", RAPI_PRIORITY_HIGH);
+  snprintf(tmpStr, sizeof(tmpStr), "$FP 0 1 %s", ipaddress.c_str());
+  rapi_send(tmpStr, RAPI_PRIORITY_HIGH);
+}
+
 // -------------------------------------------------------------------
 // Start Client, attempt to connect to Wifi network
+//
+// Returns straight away, the connection is followed up by wifi_loop()
 // -------------------------------------------------------------------
 void
 startClient() {
   DEBUG.print("Connecting to SSID: ");
-  DEBUG.println(esid.c_str());
+  DEBUG.println(config_esid());
   // DEBUG.print(" epass:");
-  // DEBUG.println(epass.c_str());
+  // DEBUG.println(config_epass());
   WiFi.hostname("openevse");
-  WiFi.begin(esid.c_str(), epass.c_str());
+  WiFi.begin(config_esid(), config_epass());
 
-  delay(50);
+  client_connecting = true;
+  client_attempt = 0;
+  client_attempt_time = millis();
+}
 
-  int t = 0;
-  int attempt = 0;
-  while (WiFi.status() != WL_CONNECTED) {
+// -------------------------------------------------------------------
+// Client connected to the Wifi network
+// -------------------------------------------------------------------
+void
+clientConnected() {
 #ifdef WIFI_LED
+  wifiLedState = WIFI_LED_ON_STATE;
+  digitalWrite(WIFI_LED, wifiLedState);
+#endif
+
+  IPAddress myAddress = WiFi.localIP();
+  char tmpStr[40];
+  sprintf(tmpStr, "%d.%d.%d.%d", myAddress[0], myAddress[1], myAddress[2],
+          myAddress[3]);
+  DEBUG.print("Connected, IP: ");
+  DEBUG.println(tmpStr);
+  // Copy the connected network and ipaddress to global strings for use in status request
+  connected_network = config_esid();
+  ipaddress = tmpStr;
+  lcdShowIp("$FP 0 0 Client-IP.......");
+
+  // Start hostname broadcast in STA mode
+  if (MDNS.begin(esp_hostname)) {
+    MDNS.addService("http", "tcp", 80);
+  }
+}
+
+// -------------------------------------------------------------------
+// Follow up a client connection started by startClient()
+// -------------------------------------------------------------------
+void
+clientLoop() {
+  if (WiFi.status() == WL_CONNECTED) {
+    client_connecting = false;
+    clientConnected();
+    return;
+  }
+
+#ifdef WIFI_LED
+  if (millis() > wifiLedTimeOut) {
     wifiLedState = !wifiLedState;
     digitalWrite(WIFI_LED, wifiLedState);
+    wifiLedTimeOut = millis() + WIFI_LED_STA_CONNECTING_TIME;
+  }
 #endif
 
-    delay(500);
-    t++;
-    // push and hold boot button after power on to skip stright to AP mode
-    if (t >= 20
+  // push and hold boot button after power on to skip stright to AP mode
+  bool skip = false;
 #if !defined(WIFI_LED) || 0 != WIFI_LED
-       || digitalRead(0) == LOW
+  skip = digitalRead(0) == LOW;
 #endif
-     ) {
-      DEBUG.println(" ");
+
+  if (skip || (millis() - client_attempt_time) >= WIFI_CLIENT_RETRY_TIME) {
+    client_attempt++;
+    if (client_attempt >= WIFI_CLIENT_ATTEMPTS || skip) {
+      client_connecting = false;
+      startAP();
+      // AP mode with SSID in EEPROM, connection will retry in 5 minutes
+      wifi_mode = WIFI_MODE_AP_STA_RETRY;
+      Timer = millis();
+    } else {
       DEBUG.println("Try Again...");
-      delay(2000);
       WiFi.disconnect();
-      WiFi.begin(esid.c_str(), epass.c_str());
-      t = 0;
-      attempt++;
-      if (attempt >= 5 || digitalRead(0) == LOW) {
-        startAP();
-        // AP mode with SSID in EEPROM, connection will retry in 5 minutes
-        wifi_mode = WIFI_MODE_AP_STA_RETRY;
-        break;
-      }
+      WiFi.begin(config_esid(), config_epass());
+      client_attempt_time = millis();
     }
   }
-
-  if (wifi_mode == WIFI_MODE_STA || wifi_mode == WIFI_MODE_AP_AND_STA) {
-#ifdef WIFI_LED
-    wifiLedState = WIFI_LED_ON_STATE;
-    digitalWrite(WIFI_LED, wifiLedState);
-#endif
-
-    IPAddress myAddress = WiFi.localIP();
-    char tmpStr[40];
-    sprintf(tmpStr, "%d.%d.%d.%d", myAddress[0], myAddress[1], myAddress[2],
-            myAddress[3]);
-    DEBUG.print("Connected, IP: ");
-    Serial.println("$FP 0 0 Client-IP.......");
-    delay(100);
-    Serial.println("$FP 0 1 ................");
-    delay(100);
-    Serial.print("$FP 0 1 ");
-    Serial.println(tmpStr);
-    DEBUG.println(tmpStr);
-    // Copy the connected network and ipaddress to global strings for use in status request
-    connected_network = esid;
-    ipaddress = tmpStr;
-  }
 }
 
 void
@@ -180,7 +223,7 @@ wifi_setup() {
 
   WiFi.disconnect();
   // 1) If no network configured start up access point
-  if (esid == 0 || esid == "") {
+  if (0 == config_esid()[0]) {
     startAP();
     wifi_mode = WIFI_MODE_AP_ONLY;      // AP mode with no SSID in EEPROM
   }
@@ -191,13 +234,6 @@ wifi_setup() {
     startClient();
   }
 
-  // Start hostname broadcast in STA mode
-  if ((wifi_mode == WIFI_MODE_STA || wifi_mode == WIFI_MODE_AP_AND_STA)) {
-    if (MDNS.begin(esp_hostname)) {
-      MDNS.addService("http", "tcp", 80);
-    }
-  }
-
   Timer = millis();
 }
 
@@ -213,6 +249,15 @@ wifi_loop() {
 
   dnsServer.processNextRequest();       // Captive portal DNS re-dierct
 
+  if (client_connecting) {
+    clientLoop();
+  }
+
+  if (apLcdTime > 0 && millis() > apLcdTime) {
+    apLcdTime = 0;
+    lcdShowIp("$FP 0 0 IP_Address......");
+  }
+
   // Remain in AP mode for 5 Minutes before resetting
   if (wifi_mode == WIFI_MODE_AP_STA_RETRY) {
     if ((millis() - Timer) >= 300000) {
@@ -246,19 +291,16 @@ wifi_scan() {
   int n = WiFi.scanNetworks();
   DEBUG.print(n);
   DEBUG.println(" networks found");
-  st = "";
-  rssi = "";
-  for (int i = 0; i < n; ++i) {
-    st += "\"" + WiFi.SSID(i) + "\"";
-    rssi += "\"" + String(WiFi.RSSI(i)) + "\"";
-    if (i < n - 1)
-      st += ",";
-    if (i < n - 1)
-      rssi += ",";
-  }
+  wifi_save_scan(n);
 }
 
 void
 wifi_disconnect() {
   WiFi.disconnect();
 }
+
+bool
+wifi_client_connected() {
+  return (wifi_mode == WIFI_MODE_STA || wifi_mode == WIFI_MODE_AP_AND_STA) &&
+         !client_connecting && WiFi.status() == WL_CONNECTED;
+}
@@ -18,8 +18,10 @@
 extern int wifi_mode;
 
 // Last discovered WiFi access points
-extern String st;
-extern String rssi;
+#define WIFI_MAX_NETWORKS 16
+extern int wifi_network_count;
+extern char wifi_network_ssid[WIFI_MAX_NETWORKS][33];
+extern int8_t wifi_network_rssi[WIFI_MAX_NETWORKS];
 
 // Network state
 extern String ipaddress;
@@ -32,5 +34,6 @@ extern void wifi_loop();
 extern void wifi_restart();
 extern void wifi_scan();
 extern void wifi_disconnect();
+extern bool wifi_client_connected();
 
 #endif // _EMONESP_WIFI_H